@@ -0,0 +1,91 @@
+/**
+ * @file	async_device.cpp
+ * @brief	Compares the throughput of the register transactions with many devices performed one after another with the
+ *          throughput of the same transactions overlapped on a single thread with coroutines.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/async_device.hpp"
+
+#include "helpers.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace jungles;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Reg8 = small_register<uint8_t, bitfield<reg::one, 3>, bitfield<reg::two, 5>>;
+using Reg16 = small_register<uint16_t, bitfield<reg::three, 4>, bitfield<reg::four, 12>>;
+
+using Map = small_map<element<0x00, Reg8>, element<0x01, Reg16>>;
+using Bus = simulated_bus<3>;
+using Device = async_device<Map, Bus>;
+
+// Roughly a register transaction on a 400 kHz I2C bus.
+constexpr auto latency{100us};
+constexpr std::size_t devices_count{32};
+
+//! Polls the status of the device and updates its counter: three transactions.
+task<unsigned> poll(Device& device)
+{
+    auto status{co_await device.read<0x00>()};
+    auto counter{co_await device.read<0x01>()};
+    counter.assign<reg::four>((counter.get<reg::four>() + status.get<reg::one>()) & 0xFFF);
+    co_await device.write(counter);
+    co_return counter.get<reg::four>();
+}
+
+task<unsigned> poll_one_after_another(std::vector<Device>& devices)
+{
+    unsigned sum{0};
+    for (auto& device : devices)
+        sum += co_await poll(device);
+    co_return sum;
+}
+
+unsigned poll_overlapped(run_loop& loop, std::vector<Device>& devices)
+{
+    std::vector<task<unsigned>> tasks;
+    tasks.reserve(devices.size());
+    for (auto& device : devices)
+    {
+        tasks.push_back(poll(device));
+        tasks.back().start(loop);
+    }
+    loop.run();
+
+    unsigned sum{0};
+    for (auto& work : tasks)
+        sum += work.result();
+    return sum;
+}
+
+} // namespace
+
+TEST_CASE("Transactions with many devices overlapped with coroutines", "[benchmark][async_device]")
+{
+    run_loop loop;
+    std::vector<Bus> buses(devices_count, Bus{loop, latency});
+    std::vector<Device> devices;
+    for (auto& bus : buses)
+    {
+        bus.memory = {0b0010'0000, 0x00, 0x00};
+        devices.emplace_back(bus);
+    }
+
+    BENCHMARK("32 devices, 3 transactions each, one after another")
+    {
+        return loop.run(poll_one_after_another(devices));
+    };
+
+    BENCHMARK("32 devices, 3 transactions each, overlapped")
+    {
+        return poll_overlapped(loop, devices);
+    };
+}
@@ -0,0 +1,138 @@
+/**
+ * @file	atomic_small_register.cpp
+ * @brief	Compares the lock-free register against a mutex-wrapped small_register, under contention of multiple threads.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/atomic_small_register.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Status = small_register<uint32_t,
+                              bitfield<reg::one, 1>,
+                              bitfield<reg::two, 1>,
+                              bitfield<reg::three, 1>,
+                              bitfield<reg::four, 1>,
+                              bitfield<reg::five, 4>,
+                              bitfield<reg::six, 8>,
+                              bitfield<reg::seven, 8>,
+                              bitfield<reg::eight, 8>>;
+
+struct mutex_wrapped_status
+{
+    template<auto Id>
+    void set()
+    {
+        std::lock_guard lock{mutex};
+        status.set<Id>();
+    }
+
+    template<auto Id>
+    void clear()
+    {
+        std::lock_guard lock{mutex};
+        status.clear<Id>();
+    }
+
+    template<auto Id>
+    void assign(uint32_t value)
+    {
+        std::lock_guard lock{mutex};
+        status.assign<Id>(value);
+    }
+
+    std::mutex mutex;
+    Status status;
+};
+
+constexpr unsigned operations_per_thread{100000};
+
+unsigned thread_count()
+{
+    return std::max(4u, std::thread::hardware_concurrency());
+}
+
+template<typename Function>
+void run_concurrently(Function function)
+{
+    std::vector<std::thread> threads;
+    for (unsigned i{0}; i < thread_count(); ++i)
+        threads.emplace_back(function, i);
+    for (auto& t : threads)
+        t.join();
+}
+
+template<typename Shared>
+void toggle_flags(Shared& shared, unsigned thread)
+{
+    for (unsigned i{0}; i < operations_per_thread; ++i)
+    {
+        if (thread % 2 == 0)
+        {
+            shared.template set<reg::one>();
+            shared.template clear<reg::one>();
+        } else
+        {
+            shared.template set<reg::two>();
+            shared.template clear<reg::two>();
+        }
+    }
+}
+
+template<typename Shared>
+void assign_fields(Shared& shared, unsigned thread)
+{
+    for (unsigned i{0}; i < operations_per_thread; ++i)
+    {
+        auto value{static_cast<uint32_t>(i & 0xFF)};
+        if (thread % 2 == 0)
+            shared.template assign<reg::six>(value);
+        else
+            shared.template assign<reg::seven>(value);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Modifying a status word shared between threads", "[benchmark][atomic]")
+{
+    atomic_small_register<Status> atomic_status;
+    mutex_wrapped_status locked_status;
+
+    BENCHMARK("Flags, mutex-wrapped small_register")
+    {
+        run_concurrently([&](unsigned thread) { toggle_flags(locked_status, thread); });
+        return locked_status.status();
+    };
+
+    BENCHMARK("Flags, atomic_small_register (fetch_or/fetch_and)")
+    {
+        run_concurrently([&](unsigned thread) { toggle_flags(atomic_status, thread); });
+        return atomic_status.load()();
+    };
+
+    BENCHMARK("Multi-bit fields, mutex-wrapped small_register")
+    {
+        run_concurrently([&](unsigned thread) { assign_fields(locked_status, thread); });
+        return locked_status.status();
+    };
+
+    BENCHMARK("Multi-bit fields, atomic_small_register (compare-exchange)")
+    {
+        run_concurrently([&](unsigned thread) { assign_fields(atomic_status, thread); });
+        return atomic_status.load()();
+    };
+}
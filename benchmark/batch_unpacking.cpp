@@ -0,0 +1,109 @@
+/**
+ * @file	batch_unpacking.cpp
+ * @brief	Compares batch unpacking and conversion of bitfields against constructing a register per sample.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register_batch.hpp"
+
+#include "helpers.hpp"
+
+#include <ratio>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Sample = small_register<uint16_t,
+                              bitfield<reg::one, 1>,
+                              bitfield<reg::two, 3>,
+                              bitfield<reg::three, 10>,
+                              bitfield<reg::four, 2>>;
+
+// Temperature of 1/16 degree per LSB in two's complement.
+using Temperature = small_register<uint16_t, signed_bitfield<reg::one, 12, std::ratio<1, 16>>, bitfield<reg::two, 4>>;
+
+std::vector<uint16_t> make_fifo(std::size_t count)
+{
+    std::vector<uint16_t> fifo(count);
+    uint32_t state{2463534242u};
+    for (auto& s : fifo)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        s = static_cast<uint16_t>(state);
+    }
+    return fifo;
+}
+
+} // namespace
+
+TEST_CASE("Batch unpacking of a FIFO burst", "[benchmark][batch]")
+{
+    constexpr std::size_t burst_size{4096};
+    const auto fifo{make_fifo(burst_size)};
+    std::vector<uint16_t> one(burst_size), two(burst_size), three(burst_size), four(burst_size);
+
+    BENCHMARK("Single bitfield: per-object get()")
+    {
+        for (std::size_t i{0}; i < burst_size; ++i)
+            three[i] = Sample{fifo[i]}.get<reg::three>();
+        return three.back();
+    };
+
+    BENCHMARK("Single bitfield: unpack()")
+    {
+        unpack<Sample, reg::three>(fifo.data(), fifo.data() + burst_size, three.data());
+        return three.back();
+    };
+
+    BENCHMARK("All bitfields: per-object get()")
+    {
+        for (std::size_t i{0}; i < burst_size; ++i)
+        {
+            Sample s{fifo[i]};
+            one[i] = s.get<reg::one>();
+            two[i] = s.get<reg::two>();
+            three[i] = s.get<reg::three>();
+            four[i] = s.get<reg::four>();
+        }
+        return four.back();
+    };
+
+    BENCHMARK("All bitfields: unpack_all()")
+    {
+        unpack_all<Sample>(fifo.data(), fifo.data() + burst_size, {one.data(), two.data(), three.data(), four.data()});
+        return four.back();
+    };
+}
+
+TEST_CASE("Batch conversion of a FIFO burst", "[benchmark][batch]")
+{
+    constexpr std::size_t burst_size{4096};
+    const auto fifo{make_fifo(burst_size)};
+    std::vector<float> temperatures(burst_size);
+
+    BENCHMARK("Raw sign extension and scaling")
+    {
+        for (std::size_t i{0}; i < burst_size; ++i)
+            temperatures[i] = static_cast<float>(static_cast<int16_t>(fifo[i]) >> 4) * 0.0625f;
+        return temperatures.back();
+    };
+
+    BENCHMARK("Per-object get_as()")
+    {
+        for (std::size_t i{0}; i < burst_size; ++i)
+            temperatures[i] = Temperature{fifo[i]}.get_as<reg::one, float>();
+        return temperatures.back();
+    };
+
+    BENCHMARK("convert()")
+    {
+        convert<Temperature, reg::one>(fifo.data(), fifo.data() + burst_size, temperatures.data());
+        return temperatures.back();
+    };
+}
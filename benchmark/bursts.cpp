@@ -0,0 +1,82 @@
+/**
+ * @file	bursts.cpp
+ * @brief	Compares reading the registers one by one against reading them in bursts.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/memory_transport.hpp"
+#include "small_register/small_map.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg = small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 3>, bitfield<reg::three, 3>>;
+
+// Register layout of MP2695: 0x00-0x02 and 0x05-0x08.
+using Map = small_map<element<0x00, Reg>,
+                      element<0x01, Reg>,
+                      element<0x02, Reg>,
+                      element<0x05, Reg>,
+                      element<0x06, Reg>,
+                      element<0x07, Reg>,
+                      element<0x08, Reg>>;
+
+//! Emulates the fixed cost of a bus transaction, e.g. sending the START condition and the device address over I2C.
+struct transport_with_overhead : memory_transport<16>
+{
+    template<typename Address>
+    void read(Address first, uint8_t* data, std::size_t size)
+    {
+        for (volatile unsigned i{0}; i < 50; i = i + 1)
+        {
+        }
+        memory_transport<16>::read(first, data, size);
+    }
+};
+
+template<typename Transport>
+unsigned read_one_by_one(Transport& bus)
+{
+    return Map::read<0x00>(bus)() + Map::read<0x01>(bus)() + Map::read<0x02>(bus)() + Map::read<0x05>(bus)()
+           + Map::read<0x06>(bus)() + Map::read<0x07>(bus)() + Map::read<0x08>(bus)();
+}
+
+template<typename Transport>
+unsigned read_in_bursts(Transport& bus)
+{
+    auto [r0, r1, r2, r5, r6, r7, r8] = Map::read<0x00, 0x01, 0x02, 0x05, 0x06, 0x07, 0x08>(bus);
+    return r0() + r1() + r2() + r5() + r6() + r7() + r8();
+}
+
+} // namespace
+
+TEST_CASE("Reading all the MP2695 registers", "[benchmark][burst]")
+{
+    memory_transport<16> bus;
+    transport_with_overhead slow_bus;
+
+    BENCHMARK("One transaction per register")
+    {
+        return read_one_by_one(bus);
+    };
+
+    BENCHMARK("Bursts of adjacent registers")
+    {
+        return read_in_bursts(bus);
+    };
+
+    BENCHMARK("One transaction per register, with transaction overhead")
+    {
+        return read_one_by_one(slow_bus);
+    };
+
+    BENCHMARK("Bursts of adjacent registers, with transaction overhead")
+    {
+        return read_in_bursts(slow_bus);
+    };
+}
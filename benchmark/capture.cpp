@@ -0,0 +1,92 @@
+/**
+ * @file	capture.cpp
+ * @brief	Compares decoding a capture of register traffic on a single thread with decoding it on all the threads.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/capture.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg8 = small_register<uint8_t, bitfield<reg::one, 3>, bitfield<reg::two, 5>>;
+using Reg16 = small_register<uint16_t, bitfield<reg::three, 4>, bitfield<reg::four, 12>>;
+using Reg32 = small_register<uint32_t, bitfield<reg::five, 20>, bitfield<reg::six, 12>>;
+
+using Map = small_map<element<0x00, Reg8>,
+                      element<0x01, Reg16>,
+                      element<0x02, Reg32>,
+                      element<0x03, Reg8>,
+                      element<0x05, Reg16>,
+                      element<0x06, Reg32>>;
+
+struct summing_visitor
+{
+    void operator()(std::uint64_t, Reg8 r)
+    {
+        sum += r.get<reg::two>();
+    }
+
+    void operator()(std::uint64_t, Reg16 r)
+    {
+        sum += r.get<reg::four>();
+    }
+
+    void operator()(std::uint64_t, Reg32 r)
+    {
+        sum += r.get<reg::six>();
+    }
+
+    std::uint64_t sum{0};
+};
+
+std::uint64_t sum_of(const std::vector<summing_visitor>& visitors)
+{
+    std::uint64_t result{0};
+    for (const auto& v : visitors)
+        result += v.sum;
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Decoding a capture on multiple threads", "[benchmark][capture]")
+{
+    std::vector<capture_record> capture(std::size_t{1} << 22);
+    capture_generator<Map>{}.generate(capture.data(), capture.data() + capture.size());
+    const auto* first{capture.data()};
+    const auto* last{capture.data() + capture.size()};
+    const auto threads{std::thread::hardware_concurrency()};
+
+    REQUIRE(sum_of(decode<Map>(first, last, summing_visitor{}, 1))
+            == sum_of(decode<Map>(first, last, summing_visitor{}, threads)));
+
+    BENCHMARK("decode(), 1 thread")
+    {
+        return sum_of(decode<Map>(first, last, summing_visitor{}, 1));
+    };
+
+    BENCHMARK("decode(), all hardware threads")
+    {
+        return sum_of(decode<Map>(first, last, summing_visitor{}, threads));
+    };
+
+    BENCHMARK("columns(), 1 thread")
+    {
+        return columns<Map, 0x06>(first, last, 1).timestamps.size();
+    };
+
+    BENCHMARK("columns(), all hardware threads")
+    {
+        return columns<Map, 0x06>(first, last, threads).timestamps.size();
+    };
+}
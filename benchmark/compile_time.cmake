@@ -0,0 +1,15 @@
+# Adds a target which measures how the compile time and the compiler memory scale with the size of the register maps.
+# The results are written to compile_time.csv in the binary directory.
+function(SmallRegister_AddCompileTimeBenchmark target)
+
+    add_custom_target(${target}
+        COMMAND ${CMAKE_COMMAND}
+            -DCOMPILER=${CMAKE_CXX_COMPILER}
+            -DINCLUDE_DIR=${PROJECT_SOURCE_DIR}
+            -DWORK_DIR=${CMAKE_CURRENT_BINARY_DIR}/compile_time
+            -DOUTPUT=${CMAKE_CURRENT_BINARY_DIR}/compile_time.csv
+            -DELEMENT_COUNTS=10,100,1000
+            -P ${CMAKE_CURRENT_LIST_DIR}/compile_time_measure.cmake
+        COMMENT "Measuring compile time of maps with 10, 100 and 1000 registers")
+
+endfunction()
@@ -0,0 +1,80 @@
+cmake_minimum_required(VERSION 3.16)
+
+# For each of the comma-separated ELEMENT_COUNTS generates a translation unit with a small_map of that many elements and
+# a register with 64 single-bit bitfields, accessing every element and every bitfield. Compiles the translation units at
+# -O2 with -ftime-report and writes the total compilation time and memory to OUTPUT as CSV. The memory is reported only
+# by GCC.
+
+function(generate_source element_count filename)
+    set(source "#include \"small_register/small_map.hpp\"\n\n#include <cstdint>\n\nusing namespace jungles;\n\n")
+
+    # A register with 64 single-bit bitfields, all of them accessed.
+    set(bits "")
+    set(bitfields "")
+    foreach(bit RANGE 63)
+        list(APPEND bits "b${bit}")
+        list(APPEND bitfields "bitfield<bit::b${bit}, 1>")
+    endforeach()
+    list(JOIN bits ", " bits)
+    list(JOIN bitfields ",\n    " bitfields)
+    string(APPEND source "enum class bit\n{\n    ${bits}\n};\n\n")
+    string(APPEND source "using Wide = small_register<uint64_t,\n    ${bitfields}>;\n\n")
+
+    # Every element has a distinct register type.
+    math(EXPR last "${element_count} - 1")
+    set(elements "")
+    foreach(i RANGE ${last})
+        math(EXPR id "${i} * 4")
+        math(EXPR id1 "${id} + 1")
+        math(EXPR id2 "${id} + 2")
+        math(EXPR id3 "${id} + 3")
+        list(APPEND elements
+            "element<${i}, small_register<uint32_t, bitfield<${id}, 8>, bitfield<${id1}, 8>, bitfield<${id2}, 8>, bitfield<${id3}, 8>>>")
+    endforeach()
+    list(JOIN elements ",\n    " elements)
+    string(APPEND source "using Map = small_map<\n    ${elements}>;\n\n")
+
+    # One function per element keeps the cost of the optimizer linear, so that the lookups dominate.
+    foreach(i RANGE ${last})
+        math(EXPR id "${i} * 4")
+        math(EXPR id2 "${id} + 2")
+        math(EXPR bit "${i} % 64")
+        string(APPEND source "uint64_t access_${i}(uint64_t value)\n{\n")
+        string(APPEND source
+            "    Map::register_from_address<${i}>::type reg{static_cast<uint32_t>(value)};\n"
+            "    Wide wide{value};\n"
+            "    return reg.set<${id}>().get<${id2}>() + wide.set<bit::b${bit}>().get<bit::b${bit}>();\n}\n\n")
+    endforeach()
+
+    file(WRITE ${filename} "${source}")
+endfunction()
+
+string(REPLACE "," ";" ELEMENT_COUNTS ${ELEMENT_COUNTS})
+file(MAKE_DIRECTORY ${WORK_DIR})
+file(WRITE ${OUTPUT} "elements,wall_seconds,memory\n")
+
+foreach(element_count IN LISTS ELEMENT_COUNTS)
+    set(source ${WORK_DIR}/compile_time_${element_count}.cpp)
+    generate_source(${element_count} ${source})
+
+    execute_process(
+        COMMAND ${COMPILER} -std=c++17 -O2 -ftime-report -I${INCLUDE_DIR} -c ${source} -o ${source}.o
+        RESULT_VARIABLE result
+        ERROR_VARIABLE report)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Compilation of ${source} failed:\n${report}")
+    endif()
+
+    # GCC: " TOTAL : <user> <sys> <wall> <memory>", Clang: "Total Execution Time: ... (<wall> wall clock)"
+    set(wall "n/a")
+    set(memory "n/a")
+    if(report MATCHES "TOTAL[ \t]*:[ \t]*[0-9.]+[ \t]+[0-9.]+[ \t]+([0-9.]+)[ \t]+([0-9.]+[kMG]?)")
+        set(wall ${CMAKE_MATCH_1})
+        set(memory ${CMAKE_MATCH_2})
+    elseif(report MATCHES "Total Execution Time: [0-9.]+ seconds \\(([0-9.]+) wall clock\\)")
+        set(wall ${CMAKE_MATCH_1})
+    endif()
+
+    message(STATUS "${element_count} elements: ${wall} s, ${memory}")
+    file(APPEND ${OUTPUT} "${element_count},${wall},${memory}\n")
+endforeach()
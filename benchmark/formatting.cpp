@@ -0,0 +1,93 @@
+/**
+ * @file	formatting.cpp
+ * @brief	Compares formatting the registers with jungles::format() against std::ostringstream.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/format.hpp"
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class status
+{
+    chg,
+    ntc,
+    therm,
+    vin,
+    reserved
+};
+
+inline constexpr char chg[]{"chg"};
+inline constexpr char ntc[]{"ntc"};
+inline constexpr char therm[]{"therm"};
+inline constexpr char vin[]{"vin"};
+inline constexpr char reserved[]{"reserved"};
+
+using Status = small_register<uint16_t,
+                              bitfield<status::chg, 2, chg>,
+                              bitfield<status::ntc, 3, ntc>,
+                              bitfield<status::therm, 1, therm>,
+                              bitfield<status::vin, 8, vin>,
+                              bitfield<status::reserved, 2, reserved>>;
+
+std::vector<Status> make_samples(std::size_t count)
+{
+    std::mt19937 generator{42};
+    std::vector<Status> result;
+    for (std::size_t i{0}; i < count; ++i)
+        result.emplace_back(static_cast<uint16_t>(generator()));
+    return result;
+}
+
+std::size_t format_with_stream(const std::vector<Status>& samples)
+{
+    std::size_t length{0};
+    for (const auto& s : samples)
+    {
+        std::ostringstream stream;
+        stream << "chg=" << s.get<status::chg>() << " ntc=" << s.get<status::ntc>()
+               << " therm=" << s.get<status::therm>() << " vin=" << s.get<status::vin>()
+               << " reserved=" << s.get<status::reserved>();
+        length += stream.str().size();
+    }
+    return length;
+}
+
+std::size_t format_to_buffer(const std::vector<Status>& samples)
+{
+    std::size_t length{0};
+    char buffer[64];
+    for (const auto& s : samples)
+        length += static_cast<std::size_t>(format(std::begin(buffer), std::end(buffer), s).ptr - buffer);
+    return length;
+}
+
+} // namespace
+
+TEST_CASE("Formatting status registers to text", "[benchmark][format]")
+{
+    auto samples{make_samples(1024)};
+
+    // That formatting to a buffer doesn't allocate is checked by SmallRegisterAllocationTests.
+    REQUIRE(format_to_buffer(samples) == format_with_stream(samples));
+
+    BENCHMARK("std::ostringstream")
+    {
+        return format_with_stream(samples);
+    };
+
+    BENCHMARK("jungles::format()")
+    {
+        return format_to_buffer(samples);
+    };
+}
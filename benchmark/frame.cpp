@@ -0,0 +1,99 @@
+/**
+ * @file	frame.cpp
+ * @brief	Compares classifying packets through in-place frame views against decoding whole headers and hand-written
+ *          code.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/frame.hpp"
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class ipv4
+{
+    version,
+    ihl,
+    dscp,
+    total_length,
+    identification,
+    flags,
+    fragment_offset,
+    ttl,
+    protocol,
+    checksum,
+    address
+};
+
+using VersionAndLength = small_register<uint32_t,
+                                        bitfield<ipv4::version, 4>,
+                                        bitfield<ipv4::ihl, 4>,
+                                        bitfield<ipv4::dscp, 8>,
+                                        bitfield<ipv4::total_length, 16>>;
+using Fragmentation = small_register<uint32_t,
+                                     bitfield<ipv4::identification, 16>,
+                                     bitfield<ipv4::flags, 3>,
+                                     bitfield<ipv4::fragment_offset, 13>>;
+using TtlAndProtocol = small_register<uint16_t, bitfield<ipv4::ttl, 8>, bitfield<ipv4::protocol, 8>>;
+using Checksum = small_register<uint16_t, bitfield<ipv4::checksum, 16>>;
+using Address = small_register<uint32_t, bitfield<ipv4::address, 32>>;
+
+using Ipv4 = frame<VersionAndLength, Fragmentation, TtlAndProtocol, Checksum, Address, Address>;
+
+constexpr uint8_t udp{17};
+
+std::vector<uint8_t> make_packets(std::size_t count)
+{
+    std::mt19937 generator{1};
+    std::uniform_int_distribution<unsigned> byte{0, 255};
+    std::vector<uint8_t> packets(count * Ipv4::size);
+    for (auto& b : packets)
+        b = static_cast<uint8_t>(byte(generator));
+    for (std::size_t i{0}; i < count; i += 2)
+        packets[i * Ipv4::size + 9] = udp;
+    return packets;
+}
+
+} // namespace
+
+TEST_CASE("Classifying IPv4 headers", "[benchmark][frame]")
+{
+    const auto packets{make_packets(4096)};
+
+    BENCHMARK("Frame views")
+    {
+        unsigned count{0};
+        for (auto header : Ipv4::frames(packets.data(), packets.size()))
+            count += header.get<ipv4::protocol>() == udp && header.get<ipv4::ttl>() > 1;
+        return count;
+    };
+
+    BENCHMARK("Decoding whole headers")
+    {
+        unsigned count{0};
+        for (auto header : Ipv4::frames(packets.data(), packets.size()))
+        {
+            auto [version_and_length, fragmentation, ttl_and_protocol, checksum, source, destination]
+                = Ipv4::decode(header.data());
+            count += ttl_and_protocol.get<ipv4::protocol>() == udp && ttl_and_protocol.get<ipv4::ttl>() > 1;
+        }
+        return count;
+    };
+
+    BENCHMARK("Hand-written")
+    {
+        unsigned count{0};
+        for (std::size_t offset{0}; offset + Ipv4::size <= packets.size(); offset += Ipv4::size)
+            count += packets[offset + 9] == udp && packets[offset + 8] > 1;
+        return count;
+    };
+}
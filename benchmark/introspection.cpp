@@ -0,0 +1,106 @@
+/**
+ * @file	introspection.cpp
+ * @brief	Compares reading the bitfields with IDs known only at runtime against a hand-written switch.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class field
+{
+    f0,
+    f1,
+    f2,
+    f3,
+    f4,
+    f5,
+    f6,
+    f7
+};
+
+using Reg = small_register<uint32_t,
+                           bitfield<field::f0, 1>,
+                           bitfield<field::f1, 3>,
+                           bitfield<field::f2, 4>,
+                           bitfield<field::f3, 8>,
+                           bitfield<field::f4, 2>,
+                           bitfield<field::f5, 6>,
+                           bitfield<field::f6, 5>,
+                           bitfield<field::f7, 3>>;
+
+uint32_t get_hand_written(uint32_t reg, field id)
+{
+    switch (id)
+    {
+    case field::f0:
+        return reg >> 31;
+    case field::f1:
+        return (reg >> 28) & 0x7;
+    case field::f2:
+        return (reg >> 24) & 0xF;
+    case field::f3:
+        return (reg >> 16) & 0xFF;
+    case field::f4:
+        return (reg >> 14) & 0x3;
+    case field::f5:
+        return (reg >> 8) & 0x3F;
+    case field::f6:
+        return (reg >> 3) & 0x1F;
+    case field::f7:
+        return reg & 0x7;
+    }
+    return 0;
+}
+
+//! Requests of a telemetry tool: the registers and the IDs of the bitfields to log, in random order.
+struct requests
+{
+    std::vector<uint32_t> registers;
+    std::vector<field> ids;
+};
+
+requests make_requests(std::size_t count)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> id_distribution{0, 7};
+    requests result;
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        result.registers.push_back(static_cast<uint32_t>(generator()));
+        result.ids.push_back(static_cast<field>(id_distribution(generator)));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Reading bitfields with IDs known at runtime", "[benchmark][introspection]")
+{
+    auto input{make_requests(4096)};
+
+    BENCHMARK("Hand-written switch")
+    {
+        uint32_t sum{0};
+        for (std::size_t i{0}; i < input.ids.size(); ++i)
+            sum += get_hand_written(input.registers[i], input.ids[i]);
+        return sum;
+    };
+
+    BENCHMARK("Lookup table of small_register")
+    {
+        uint32_t sum{0};
+        for (std::size_t i{0}; i < input.ids.size(); ++i)
+            sum += Reg{input.registers[i]}.get(input.ids[i]);
+        return sum;
+    };
+}
@@ -0,0 +1,166 @@
+/**
+ * @file	operations.cpp
+ * @brief	Compares the basic register operations, for registers of all the sizes, and the registers looked up in
+ *          small_map, against raw shift and mask code.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+constexpr std::size_t count{4096};
+
+//! Register with a bitfield in the middle, which takes half of the register.
+template<typename T>
+using Reg = small_register<T,
+                           bitfield<reg::one, sizeof(T) * 2>,
+                           bitfield<reg::two, sizeof(T) * 4>,
+                           bitfield<reg::three, sizeof(T) * 2>>;
+
+template<typename T>
+struct raw_layout
+{
+    static inline constexpr unsigned one_shift{sizeof(T) * 6};
+    static inline constexpr unsigned two_shift{sizeof(T) * 2};
+    static inline constexpr T one_mask{static_cast<T>((T{1} << (sizeof(T) * 2)) - 1)};
+    static inline constexpr T two_mask{static_cast<T>((T{1} << (sizeof(T) * 4)) - 1)};
+    static inline constexpr T three_mask{one_mask};
+};
+
+template<typename T>
+std::vector<T> make_values(T max)
+{
+    std::vector<T> values(count);
+    for (std::size_t i{0}; i < count; ++i)
+        values[i] = static_cast<T>((i * 2654435761u) & max);
+    return values;
+}
+
+template<typename T>
+void benchmark_operations(const std::string& type_name)
+{
+    using L = raw_layout<T>;
+
+    const auto values{make_values<T>(L::two_mask)};
+    const auto small_values{make_values<T>(L::one_mask)};
+    std::vector<T> raw(count);
+    std::vector<Reg<T>> registers(count);
+
+    BENCHMARK("get, raw shift and mask, " + type_name)
+    {
+        T sum{0};
+        for (auto r : raw)
+            sum = static_cast<T>(sum + ((r >> L::two_shift) & L::two_mask));
+        return sum;
+    };
+
+    BENCHMARK("get, small_register, " + type_name)
+    {
+        T sum{0};
+        for (auto r : registers)
+            sum = static_cast<T>(sum + r.template get<reg::two>());
+        return sum;
+    };
+
+    BENCHMARK("set, raw shift and mask, " + type_name)
+    {
+        for (std::size_t i{0}; i < count; ++i)
+            raw[i] = static_cast<T>(raw[i] | (values[i] << L::two_shift));
+        return raw.back();
+    };
+
+    BENCHMARK("set, small_register, " + type_name)
+    {
+        for (std::size_t i{0}; i < count; ++i)
+            registers[i].template set<reg::two>(values[i]);
+        return registers.back()();
+    };
+
+    BENCHMARK("clear, raw shift and mask, " + type_name)
+    {
+        for (std::size_t i{0}; i < count; ++i)
+            raw[i] = static_cast<T>(raw[i] & ~(values[i] << L::two_shift));
+        return raw.back();
+    };
+
+    BENCHMARK("clear, small_register, " + type_name)
+    {
+        for (std::size_t i{0}; i < count; ++i)
+            registers[i].template clear<reg::two>(values[i]);
+        return registers.back()();
+    };
+
+    BENCHMARK("chaining, raw shift and mask, " + type_name)
+    {
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            auto r{static_cast<T>((raw[i] & ~(L::one_mask << L::one_shift)) | (small_values[i] << L::one_shift))};
+            r = static_cast<T>(r | L::three_mask);
+            raw[i] = static_cast<T>(r & ~(L::two_mask << L::two_shift));
+        }
+        return raw.back();
+    };
+
+    BENCHMARK("chaining, small_register, " + type_name)
+    {
+        for (std::size_t i{0}; i < count; ++i)
+            registers[i].template assign<reg::one>(small_values[i]).template set<reg::three>().template clear<reg::two>();
+        return registers.back()();
+    };
+}
+
+using Status = small_register<uint8_t, bitfield<reg::one, 1>, bitfield<reg::two, 3>, bitfield<reg::three, 4>>;
+using Control = small_register<uint8_t, bitfield<reg::four, 5>, bitfield<reg::five, 3>>;
+using Map = small_map<element<0x00, Control>, element<0x03, Status>, element<0x07, Control>>;
+
+} // namespace
+
+TEST_CASE("Register operations against raw shift and mask code", "[benchmark][operations]")
+{
+    benchmark_operations<uint8_t>("uint8_t");
+    benchmark_operations<uint16_t>("uint16_t");
+    benchmark_operations<uint32_t>("uint32_t");
+    benchmark_operations<uint64_t>("uint64_t");
+}
+
+TEST_CASE("Registers looked up in small_map against raw shift and mask code", "[benchmark][operations][map]")
+{
+    std::vector<std::array<uint8_t, 8>> images(count);
+    for (std::size_t i{0}; i < count; ++i)
+        for (std::size_t j{0}; j < 8; ++j)
+            images[i][j] = static_cast<uint8_t>((i * 2654435761u) >> j);
+
+    BENCHMARK("Raw shift and mask")
+    {
+        unsigned sum{0};
+        for (const auto& image : images)
+            sum += ((image[0x03] >> 4) & 0x7) + (image[0x00] >> 3) + (image[0x07] & 0x7);
+        return sum;
+    };
+
+    BENCHMARK("small_map")
+    {
+        unsigned sum{0};
+        for (const auto& image : images)
+        {
+            Map::register_from_address<0x00>::type control0{image[0x00]};
+            Map::register_from_address<0x03>::type status{image[0x03]};
+            Map::register_from_address<0x07>::type control1{image[0x07]};
+            sum += status.get<reg::two>() + control0.get<reg::four>() + control1.get<reg::five>();
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,84 @@
+/**
+ * @file	overflow_policies.cpp
+ * @brief	Compares the cost of assigning a bitfield under the various overflow policies.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+template<typename Policy>
+using Config = basic_small_register<Policy, uint16_t, bitfield<reg::one, 4>, bitfield<reg::two, 10>, bitfield<reg::three, 2>>;
+
+template<typename Policy>
+uint16_t assign_all(std::vector<Config<Policy>>& registers, const std::vector<uint16_t>& values)
+{
+    for (std::size_t i{0}; i < values.size(); ++i)
+        (void)registers[i].template assign<reg::two>(values[i]);
+    return registers.back()();
+}
+
+} // namespace
+
+TEST_CASE("Assigning a bitfield under the overflow policies", "[benchmark][policy]")
+{
+    constexpr std::size_t count{4096};
+    std::vector<uint16_t> values(count);
+    for (std::size_t i{0}; i < count; ++i)
+        values[i] = static_cast<uint16_t>((i * 2654435761u) & 0x3FF);
+
+    std::vector<uint16_t> raw(count);
+    std::vector<Config<overflow::throw_error>> throwing(count);
+    std::vector<Config<overflow::return_error>> returning(count);
+    std::vector<Config<overflow::truncate>> truncating(count);
+    std::vector<Config<overflow::saturate>> saturating(count);
+    std::vector<Config<overflow::unchecked>> unchecked(count);
+
+    BENCHMARK("Raw shift and mask")
+    {
+        for (std::size_t i{0}; i < count; ++i)
+            raw[i] = static_cast<uint16_t>((raw[i] & ~(0x3FF << 2)) | (values[i] << 2));
+        return raw.back();
+    };
+
+    BENCHMARK("overflow::throw_error")
+    {
+        return assign_all(throwing, values);
+    };
+
+    BENCHMARK("overflow::return_error")
+    {
+        return assign_all(returning, values);
+    };
+
+    BENCHMARK("overflow::truncate")
+    {
+        return assign_all(truncating, values);
+    };
+
+    BENCHMARK("overflow::saturate")
+    {
+        return assign_all(saturating, values);
+    };
+
+    BENCHMARK("overflow::unchecked")
+    {
+        return assign_all(unchecked, values);
+    };
+
+    BENCHMARK("Compile-time value")
+    {
+        for (auto& r : throwing)
+            r.assign<reg::two, 0x155>();
+        return throwing.back()();
+    };
+}
@@ -0,0 +1,142 @@
+/**
+ * @file	register_diff.cpp
+ * @brief	Compares dispatching the changes of a polled status register against comparing every bitfield by hand.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/register_diff.hpp"
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class status
+{
+    s0,
+    s1,
+    s2,
+    s3,
+    s4,
+    s5,
+    s6,
+    s7,
+    s8,
+    s9,
+    s10,
+    s11,
+    s12,
+    s13,
+    s14,
+    s15
+};
+
+using Status = small_register<uint64_t,
+                              bitfield<status::s0, 4>,
+                              bitfield<status::s1, 4>,
+                              bitfield<status::s2, 4>,
+                              bitfield<status::s3, 4>,
+                              bitfield<status::s4, 4>,
+                              bitfield<status::s5, 4>,
+                              bitfield<status::s6, 4>,
+                              bitfield<status::s7, 4>,
+                              bitfield<status::s8, 4>,
+                              bitfield<status::s9, 4>,
+                              bitfield<status::s10, 4>,
+                              bitfield<status::s11, 4>,
+                              bitfield<status::s12, 4>,
+                              bitfield<status::s13, 4>,
+                              bitfield<status::s14, 4>,
+                              bitfield<status::s15, 4>>;
+
+//! Samples of a status register, in which a single bitfield changes in one of 16 samples.
+std::vector<Status> make_samples(std::size_t count)
+{
+    std::mt19937_64 generator{1};
+    std::vector<Status> samples(count);
+    uint64_t value{0};
+    for (auto& sample : samples)
+    {
+        if (generator() % 16 == 0)
+            value ^= uint64_t{1} << (generator() % 64);
+        sample = Status{value};
+    }
+    return samples;
+}
+
+template<auto Id>
+auto counting_handler(unsigned& counter)
+{
+    return on<Id>([&counter](auto, auto) { ++counter; });
+}
+
+template<auto Id>
+void compare(const Status& previous, const Status& current, unsigned& counter)
+{
+    if (previous.get<Id>() != current.get<Id>())
+        ++counter;
+}
+
+} // namespace
+
+TEST_CASE("Dispatching the changes of a polled status register", "[benchmark][register_diff]")
+{
+    const auto samples{make_samples(4096)};
+    unsigned counter{0};
+
+    BENCHMARK("Comparing every bitfield")
+    {
+        for (std::size_t i{1}; i < samples.size(); ++i)
+        {
+            const auto& p{samples[i - 1]};
+            const auto& c{samples[i]};
+            compare<status::s0>(p, c, counter);
+            compare<status::s1>(p, c, counter);
+            compare<status::s2>(p, c, counter);
+            compare<status::s3>(p, c, counter);
+            compare<status::s4>(p, c, counter);
+            compare<status::s5>(p, c, counter);
+            compare<status::s6>(p, c, counter);
+            compare<status::s7>(p, c, counter);
+            compare<status::s8>(p, c, counter);
+            compare<status::s9>(p, c, counter);
+            compare<status::s10>(p, c, counter);
+            compare<status::s11>(p, c, counter);
+            compare<status::s12>(p, c, counter);
+            compare<status::s13>(p, c, counter);
+            compare<status::s14>(p, c, counter);
+            compare<status::s15>(p, c, counter);
+        }
+        return counter;
+    };
+
+    auto dispatch{make_dispatcher<Status>(counting_handler<status::s0>(counter),
+                                          counting_handler<status::s1>(counter),
+                                          counting_handler<status::s2>(counter),
+                                          counting_handler<status::s3>(counter),
+                                          counting_handler<status::s4>(counter),
+                                          counting_handler<status::s5>(counter),
+                                          counting_handler<status::s6>(counter),
+                                          counting_handler<status::s7>(counter),
+                                          counting_handler<status::s8>(counter),
+                                          counting_handler<status::s9>(counter),
+                                          counting_handler<status::s10>(counter),
+                                          counting_handler<status::s11>(counter),
+                                          counting_handler<status::s12>(counter),
+                                          counting_handler<status::s13>(counter),
+                                          counting_handler<status::s14>(counter),
+                                          counting_handler<status::s15>(counter))};
+
+    BENCHMARK("change_dispatcher")
+    {
+        for (std::size_t i{1}; i < samples.size(); ++i)
+            dispatch(samples[i - 1], samples[i]);
+        return counter;
+    };
+}
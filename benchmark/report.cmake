@@ -0,0 +1,15 @@
+# Adds a target which runs the benchmarks and exports their results, for tracking regressions between releases. The
+# results are written to benchmark_results.xml, as reported by Catch2, and to benchmark_results.csv in the binary
+# directory.
+function(SmallRegister_AddBenchmarkReport target benchmarks)
+
+    add_custom_target(${target}
+        COMMAND ${CMAKE_COMMAND}
+            -DBENCHMARKS=$<TARGET_FILE:${benchmarks}>
+            -DXML_OUTPUT=${CMAKE_CURRENT_BINARY_DIR}/benchmark_results.xml
+            -DCSV_OUTPUT=${CMAKE_CURRENT_BINARY_DIR}/benchmark_results.csv
+            -P ${CMAKE_CURRENT_LIST_DIR}/report_export.cmake
+        DEPENDS ${benchmarks}
+        COMMENT "Running the benchmarks and exporting the results")
+
+endfunction()
@@ -0,0 +1,59 @@
+cmake_minimum_required(VERSION 3.16)
+
+# Runs the BENCHMARKS executable with the Catch2 XML reporter, writing XML_OUTPUT, and converts the results to CSV,
+# written to CSV_OUTPUT: one row per benchmark with the mean and the standard deviation in nanoseconds, and the bounds
+# of their 95% confidence intervals.
+
+function(xml_attribute line name result)
+    if(line MATCHES " ${name}=\"([^\"]*)\"")
+        set(value "${CMAKE_MATCH_1}")
+        string(REPLACE "&quot;" "\"" value "${value}")
+        string(REPLACE "&apos;" "'" value "${value}")
+        string(REPLACE "&lt;" "<" value "${value}")
+        string(REPLACE "&gt;" ">" value "${value}")
+        string(REPLACE "&amp;" "&" value "${value}")
+        set(${result} "${value}" PARENT_SCOPE)
+    else()
+        set(${result} "" PARENT_SCOPE)
+    endif()
+endfunction()
+
+function(csv_quote value result)
+    string(REPLACE "\"" "\"\"" value "${value}")
+    set(${result} "\"${value}\"" PARENT_SCOPE)
+endfunction()
+
+execute_process(
+    COMMAND ${BENCHMARKS} "[benchmark]" --reporter xml --out ${XML_OUTPUT}
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Benchmarks failed: ${result}")
+endif()
+
+file(STRINGS ${XML_OUTPUT} lines)
+set(csv "test_case,benchmark,samples,mean_ns,mean_lower_ns,mean_upper_ns,std_dev_ns,std_dev_lower_ns,std_dev_upper_ns\n")
+set(count 0)
+foreach(line IN LISTS lines)
+    if(line MATCHES "<TestCase ")
+        xml_attribute("${line}" name test_case)
+        csv_quote("${test_case}" test_case)
+    elseif(line MATCHES "<BenchmarkResults ")
+        xml_attribute("${line}" name benchmark)
+        csv_quote("${benchmark}" benchmark)
+        xml_attribute("${line}" samples samples)
+    elseif(line MATCHES "<mean ")
+        xml_attribute("${line}" value mean)
+        xml_attribute("${line}" lowerBound mean_lower)
+        xml_attribute("${line}" upperBound mean_upper)
+    elseif(line MATCHES "<standardDeviation ")
+        xml_attribute("${line}" value std_dev)
+        xml_attribute("${line}" lowerBound std_dev_lower)
+        xml_attribute("${line}" upperBound std_dev_upper)
+        string(APPEND csv "${test_case},${benchmark},${samples},${mean},${mean_lower},${mean_upper},")
+        string(APPEND csv "${std_dev},${std_dev_lower},${std_dev_upper}\n")
+        math(EXPR count "${count} + 1")
+    endif()
+endforeach()
+
+file(WRITE ${CSV_OUTPUT} "${csv}")
+message(STATUS "Exported ${count} benchmark results to ${CSV_OUTPUT}")
@@ -0,0 +1,210 @@
+/**
+ * @file	visiting.cpp
+ * @brief	Compares decoding a stream of (address, raw value) records with small_map::visit and a hand-written switch.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_map.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg8 = small_register<uint8_t, bitfield<reg::one, 3>, bitfield<reg::two, 5>>;
+using Reg16 = small_register<uint16_t, bitfield<reg::three, 4>, bitfield<reg::four, 12>>;
+using Reg32 = small_register<uint32_t, bitfield<reg::five, 20>, bitfield<reg::six, 12>>;
+
+using DenseMap = small_map<element<0x00, Reg8>,
+                           element<0x01, Reg16>,
+                           element<0x02, Reg32>,
+                           element<0x03, Reg8>,
+                           element<0x05, Reg16>,
+                           element<0x06, Reg32>,
+                           element<0x07, Reg8>,
+                           element<0x08, Reg16>,
+                           element<0x0A, Reg32>,
+                           element<0x0B, Reg8>,
+                           element<0x0C, Reg16>,
+                           element<0x0D, Reg32>>;
+
+using SparseMap = small_map<element<0x0000, Reg8>,
+                            element<0x0010, Reg16>,
+                            element<0x0400, Reg32>,
+                            element<0x0404, Reg8>,
+                            element<0x1000, Reg16>,
+                            element<0x1004, Reg32>,
+                            element<0x2000, Reg8>,
+                            element<0x4000, Reg16>,
+                            element<0x4100, Reg32>,
+                            element<0x8000, Reg8>,
+                            element<0x8008, Reg16>,
+                            element<0xC000, Reg32>>;
+
+struct record
+{
+    uint32_t address;
+    uint32_t value;
+};
+
+struct summing_visitor
+{
+    void operator()(Reg8 r)
+    {
+        sum += r.get<reg::two>();
+    }
+
+    void operator()(Reg16 r)
+    {
+        sum += r.get<reg::four>();
+    }
+
+    void operator()(Reg32 r)
+    {
+        sum += r.get<reg::five>();
+    }
+
+    uint64_t sum{0};
+};
+
+template<typename Map, std::size_t... Indices>
+void fill_addresses(std::vector<record>& stream, std::index_sequence<Indices...>)
+{
+    constexpr std::array<uint32_t, sizeof...(Indices)> addresses{
+        static_cast<uint32_t>(std::tuple_element_t<Indices, typename Map::elements>::address)...};
+    uint32_t state{6789};
+    for (auto& r : stream)
+    {
+        if (r.address != 0)
+            continue;
+        state = state * 1664525u + 1013904223u;
+        r.address = addresses[(state >> 16) % addresses.size()];
+    }
+}
+
+//! One in 16 records has the unknown address, the others have random addresses of the map.
+template<typename Map>
+std::vector<record> make_records(std::size_t count, uint32_t unknown_address)
+{
+    std::vector<record> stream(count);
+    uint32_t state{12345};
+    for (auto& r : stream)
+    {
+        state = state * 1664525u + 1013904223u;
+        r.value = state;
+        r.address = ((state >> 16) % 16) == 0 ? unknown_address : 0;
+    }
+    fill_addresses<Map>(stream, std::make_index_sequence<Map::size>{});
+    return stream;
+}
+
+template<typename Map>
+uint64_t decode_with_visit(const std::vector<record>& stream)
+{
+    summing_visitor visitor;
+    for (const auto& r : stream)
+        Map::visit(r.address, r.value, visitor);
+    return visitor.sum;
+}
+
+uint64_t decode_dense_with_switch(const std::vector<record>& stream)
+{
+    summing_visitor visitor;
+    for (const auto& r : stream)
+    {
+        switch (r.address)
+        {
+        case 0x00:
+        case 0x03:
+        case 0x07:
+        case 0x0B:
+            visitor(Reg8{static_cast<uint8_t>(r.value)});
+            break;
+        case 0x01:
+        case 0x05:
+        case 0x08:
+        case 0x0C:
+            visitor(Reg16{static_cast<uint16_t>(r.value)});
+            break;
+        case 0x02:
+        case 0x06:
+        case 0x0A:
+        case 0x0D:
+            visitor(Reg32{r.value});
+            break;
+        default:
+            break;
+        }
+    }
+    return visitor.sum;
+}
+
+uint64_t decode_sparse_with_switch(const std::vector<record>& stream)
+{
+    summing_visitor visitor;
+    for (const auto& r : stream)
+    {
+        switch (r.address)
+        {
+        case 0x0000:
+        case 0x0404:
+        case 0x2000:
+        case 0x8000:
+            visitor(Reg8{static_cast<uint8_t>(r.value)});
+            break;
+        case 0x0010:
+        case 0x1000:
+        case 0x4000:
+        case 0x8008:
+            visitor(Reg16{static_cast<uint16_t>(r.value)});
+            break;
+        case 0x0400:
+        case 0x1004:
+        case 0x4100:
+        case 0xC000:
+            visitor(Reg32{r.value});
+            break;
+        default:
+            break;
+        }
+    }
+    return visitor.sum;
+}
+
+} // namespace
+
+TEST_CASE("Decoding a stream of 4M register records", "[benchmark][visit]")
+{
+    constexpr std::size_t count{1u << 22};
+    auto dense_stream{make_records<DenseMap>(count, 0x04)};
+    auto sparse_stream{make_records<SparseMap>(count, 0x0401)};
+
+    REQUIRE(decode_with_visit<DenseMap>(dense_stream) == decode_dense_with_switch(dense_stream));
+    REQUIRE(decode_with_visit<SparseMap>(sparse_stream) == decode_sparse_with_switch(sparse_stream));
+
+    BENCHMARK("Dense addresses, hand-written switch")
+    {
+        return decode_dense_with_switch(dense_stream);
+    };
+
+    BENCHMARK("Dense addresses, small_map::visit")
+    {
+        return decode_with_visit<DenseMap>(dense_stream);
+    };
+
+    BENCHMARK("Sparse addresses, hand-written switch")
+    {
+        return decode_sparse_with_switch(sparse_stream);
+    };
+
+    BENCHMARK("Sparse addresses, small_map::visit")
+    {
+        return decode_with_visit<SparseMap>(sparse_stream);
+    };
+}
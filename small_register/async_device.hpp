@@ -0,0 +1,466 @@
+/**
+ * @file	async_device.hpp
+ * @brief	Reads and writes the registers of a small_map with C++20 coroutines, so that the transactions with many
+ *          devices can be in flight on a single thread.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef ASYNC_DEVICE_HPP
+#define ASYNC_DEVICE_HPP
+
+#include "small_register/byte_order.hpp"
+#include "small_register/memory_transport.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "async_device.hpp requires C++20 coroutines"
+#endif
+
+#include <coroutine>
+
+namespace jungles
+{
+
+template<typename T = void>
+class task;
+
+namespace detail
+{
+
+class task_promise_base
+{
+  public:
+    //! Resumes the awaiting coroutine, if any, without growing the stack.
+    struct final_awaiter
+    {
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> coroutine) noexcept
+        {
+            auto continuation{coroutine.promise().continuation};
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept
+        {
+        }
+    };
+
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    final_awaiter final_suspend() noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        exception = std::current_exception();
+    }
+
+    std::coroutine_handle<> continuation;
+
+  protected:
+    void rethrow_if_failed() const
+    {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+  private:
+    std::exception_ptr exception;
+};
+
+template<typename T>
+class task_promise : public task_promise_base
+{
+  public:
+    template<typename U>
+    void return_value(U&& result)
+    {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T result()
+    {
+        rethrow_if_failed();
+        return std::move(*value);
+    }
+
+  private:
+    std::optional<T> value;
+};
+
+template<>
+class task_promise<void> : public task_promise_base
+{
+  public:
+    void return_void() noexcept
+    {
+    }
+
+    void result()
+    {
+        rethrow_if_failed();
+    }
+};
+
+//! Position of the element of the map holding the SmallRegister, or the number of the elements when not found.
+template<typename SmallRegister, typename... Elements>
+constexpr std::size_t find_register(std::tuple<Elements...>*)
+{
+    constexpr std::array<bool, sizeof...(Elements)> matches{
+        std::is_same_v<typename Elements::Register, SmallRegister>...};
+    auto found{std::find(matches.begin(), matches.end(), true)};
+    if (std::find(found == matches.end() ? found : found + 1, matches.end(), true) != matches.end())
+        return sizeof...(Elements) + 1;
+    return static_cast<std::size_t>(found - matches.begin());
+}
+
+} // namespace detail
+
+/**
+ * \brief Coroutine which produces a T, started when awaited with "co_await", or by start() from an executor.
+ *
+ * The task is lazy: nothing is executed until it is awaited or started. The awaiting coroutine is resumed when the task
+ * completes, with the result or the exception thrown by the task. The task owns the coroutine and is move-only.
+ */
+template<typename T>
+class task
+{
+  public:
+    struct promise_type : detail::task_promise<T>
+    {
+        task get_return_object() noexcept
+        {
+            return task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+    };
+
+    task(task&& other) noexcept : coroutine{std::exchange(other.coroutine, nullptr)}
+    {
+    }
+
+    task& operator=(task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (coroutine)
+                coroutine.destroy();
+            coroutine = std::exchange(other.coroutine, nullptr);
+        }
+        return *this;
+    }
+
+    ~task()
+    {
+        if (coroutine)
+            coroutine.destroy();
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct awaiter
+        {
+            bool await_ready() noexcept
+            {
+                return coroutine.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                coroutine.promise().continuation = awaiting;
+                return coroutine;
+            }
+
+            T await_resume()
+            {
+                return coroutine.promise().result();
+            }
+
+            std::coroutine_handle<promise_type> coroutine;
+        };
+        return awaiter{coroutine};
+    }
+
+    /**
+     * \brief Schedules the task on the executor, without any awaiting coroutine, e.g. to run many tasks concurrently.
+     *
+     * The task shall outlive its execution; check is_ready() and get the result with result().
+     */
+    template<typename Executor>
+    void start(Executor& executor)
+    {
+        executor.post(coroutine);
+    }
+
+    //! Tells whether the task completed.
+    bool is_ready() const noexcept
+    {
+        return coroutine.done();
+    }
+
+    //! Returns the result of the completed task, or rethrows the exception which the task has thrown.
+    T result()
+    {
+        return coroutine.promise().result();
+    }
+
+  private:
+    explicit task(std::coroutine_handle<promise_type> coroutine) noexcept : coroutine{coroutine}
+    {
+    }
+
+    std::coroutine_handle<promise_type> coroutine;
+};
+
+/**
+ * \brief Single-threaded executor: resumes the coroutines posted to it, in order, from run().
+ *
+ * Any executor can be used instead, as long as it provides:
+ * - "void post(std::coroutine_handle<> coroutine)" - resumes the coroutine later, used by task::start(),
+ * - "void post_at(std::chrono::steady_clock::time_point time, std::coroutine_handle<> coroutine)" - resumes the
+ *   coroutine not earlier than at the time, used by jungles::simulated_bus.
+ * The real buses need only post(), e.g. called from the completion callbacks of their drivers.
+ */
+class run_loop
+{
+  public:
+    using clock = std::chrono::steady_clock;
+
+    void post(std::coroutine_handle<> coroutine)
+    {
+        ready.push_back(coroutine);
+    }
+
+    void post_at(clock::time_point time, std::coroutine_handle<> coroutine)
+    {
+        timers.push(timer{time, sequence++, coroutine});
+    }
+
+    //! Resumes the posted coroutines, waiting for the timers when nothing else is ready, until no work is left.
+    void run()
+    {
+        while (!ready.empty() || !timers.empty())
+        {
+            while (!ready.empty())
+            {
+                auto coroutine{ready.front()};
+                ready.pop_front();
+                coroutine.resume();
+            }
+
+            if (!timers.empty())
+            {
+                std::this_thread::sleep_until(timers.top().time);
+                for (auto now{clock::now()}; !timers.empty() && timers.top().time <= now; timers.pop())
+                    ready.push_back(timers.top().coroutine);
+            }
+        }
+    }
+
+    //! Starts the task, runs until no work is left and returns the result of the task.
+    template<typename T>
+    T run(task<T> work)
+    {
+        work.start(*this);
+        run();
+        return work.result();
+    }
+
+  private:
+    struct timer
+    {
+        clock::time_point time;
+        //! Resumes the coroutines with equal times in the order of posting.
+        std::uint64_t order;
+        std::coroutine_handle<> coroutine;
+
+        bool operator>(const timer& other) const
+        {
+            return std::tie(time, order) > std::tie(other.time, other.order);
+        }
+    };
+
+    std::deque<std::coroutine_handle<>> ready;
+    std::priority_queue<timer, std::vector<timer>, std::greater<>> timers;
+    std::uint64_t sequence{0};
+};
+
+/**
+ * \brief Emulates a device with Size bytes of register space, behind a bus with the latency, for jungles::async_device.
+ *
+ * The memory is accessed when a transaction is started; the awaiting coroutine is resumed through the Executor after
+ * the latency. The transactions with a single device are performed one after another, while the transactions with
+ * different devices overlap. The synchronous read() and write() of jungles::memory_transport are available as well.
+ */
+template<std::size_t Size, typename Executor = run_loop>
+class simulated_bus : public memory_transport<Size>
+{
+  public:
+    using clock = std::chrono::steady_clock;
+
+    simulated_bus(Executor& executor, clock::duration latency) : executor{executor}, latency{latency}
+    {
+    }
+
+    using memory_transport<Size>::read;
+    using memory_transport<Size>::write;
+
+    //! Reads size bytes starting from the address first and resumes the coroutine after the latency.
+    template<typename Address>
+    void read(Address first, uint8_t* data, std::size_t size, std::coroutine_handle<> done)
+    {
+        memory_transport<Size>::read(first, data, size);
+        complete(done);
+    }
+
+    //! Writes size bytes starting from the address first and resumes the coroutine after the latency.
+    template<typename Address>
+    void write(Address first, const uint8_t* data, std::size_t size, std::coroutine_handle<> done)
+    {
+        memory_transport<Size>::write(first, data, size);
+        complete(done);
+    }
+
+  private:
+    void complete(std::coroutine_handle<> done)
+    {
+        busy_until = std::max(clock::now(), busy_until) + latency;
+        executor.post_at(busy_until, done);
+    }
+
+    Executor& executor;
+    clock::duration latency;
+    clock::time_point busy_until{};
+};
+
+/**
+ * \brief Reads and writes the registers of the small_map with "co_await", over an asynchronous Transport.
+ *
+ * E.g. "auto r{co_await device.read<0x01>()};" and "co_await device.write(r);". While a transaction is in flight the
+ * coroutine is suspended, so that a single thread can drive the transactions with many devices at once. Multi-byte
+ * registers are transferred most significant byte first, as by small_map::read().
+ *
+ * The Transport shall provide:
+ * - "void read(Address first, uint8_t* data, std::size_t size, std::coroutine_handle<> done)",
+ * - "void write(Address first, const uint8_t* data, std::size_t size, std::coroutine_handle<> done)",
+ * which start the transaction and resume done, e.g. through an executor, once it completes, but not from within the
+ * call. The buffer is valid until done is resumed. Errors thrown when starting the transaction are thrown from
+ * "co_await". See jungles::simulated_bus.
+ */
+template<typename Map, typename Transport>
+class async_device
+{
+  public:
+    //! Type of the register under the Address.
+    template<auto Address>
+    using register_type = typename Map::template register_from_address<Address>::type;
+
+    explicit async_device(Transport& transport) : transport{transport}
+    {
+    }
+
+    //! Returns the awaitable which reads the register under the Address and produces it.
+    template<auto Address>
+    auto read()
+    {
+        static_assert(!detail::is_write_only<register_type<Address>>, "Write-only register can't be read");
+        return read_awaiter<Address>{transport};
+    }
+
+    //! Returns the awaitable which writes the register under the Address.
+    template<auto Address>
+    auto write(const register_type<Address>& reg)
+    {
+        write_awaiter<Address> result{transport};
+        store_be(reg, result.buffer.data());
+        return result;
+    }
+
+    //! Returns the awaitable which writes the register under the address of the only element of its type.
+    template<typename SmallRegister>
+    auto write(const SmallRegister& reg)
+    {
+        constexpr auto position{detail::find_register<SmallRegister>(static_cast<typename Map::elements*>(nullptr))};
+        static_assert(position <= Map::size, "Register type is ambiguous within the map, specify the address");
+        static_assert(position < Map::size, "Register type not found in the map");
+        return write<std::tuple_element_t<position, typename Map::elements>::address>(reg);
+    }
+
+  private:
+    template<auto Address>
+    using buffer_type = std::array<uint8_t, sizeof(typename register_type<Address>::underlying_type)>;
+
+    template<auto Address>
+    struct read_awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> awaiting)
+        {
+            transport.read(Address, buffer.data(), buffer.size(), awaiting);
+        }
+
+        register_type<Address> await_resume() const
+        {
+            return load_be<register_type<Address>>(buffer.data());
+        }
+
+        Transport& transport;
+        buffer_type<Address> buffer{};
+    };
+
+    template<auto Address>
+    struct write_awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> awaiting)
+        {
+            transport.write(Address, static_cast<const uint8_t*>(buffer.data()), buffer.size(), awaiting);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+        Transport& transport;
+        buffer_type<Address> buffer{};
+    };
+
+    Transport& transport;
+};
+
+} // namespace jungles
+
+#endif /* ASYNC_DEVICE_HPP */
@@ -0,0 +1,220 @@
+/**
+ * @file	atomic_small_register.hpp
+ * @brief	Lock-free register with the layout of a small_register, which can be shared between threads.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef ATOMIC_SMALL_REGISTER_HPP
+#define ATOMIC_SMALL_REGISTER_HPP
+
+#include "small_register/small_register_internal.hpp"
+
+#include <atomic>
+#include <system_error>
+#include <type_traits>
+
+namespace jungles
+{
+
+namespace detail
+{
+
+//! Memory order of the failed compare-exchange, which can't be stronger than the order of the successful one.
+constexpr std::memory_order failure_order(std::memory_order order)
+{
+    if (order == std::memory_order_acq_rel)
+        return std::memory_order_acquire;
+    if (order == std::memory_order_release)
+        return std::memory_order_relaxed;
+    return order;
+}
+
+} // namespace detail
+
+/**
+ * \brief Register with the layout of SmallRegister, which can be modified concurrently by multiple threads, without
+ *        locks.
+ *
+ * - set() maps to a single fetch_or(),
+ * - clear() maps to a single fetch_and(),
+ * - assign() and modify() use a compare-exchange loop, because they set some bits and clear the others.
+ *
+ * The values are checked, or adjusted, according to the overflow policy of the SmallRegister before the register is
+ * modified, once per operation. The mutating methods return the register before the modification. Under
+ * jungles::overflow::return_error the methods taking runtime values return std::errc instead and leave the register
+ * unchanged on error.
+ *
+ * Each method takes the memory order as the last, optional, argument, std::memory_order_seq_cst by default.
+ *
+ * \tparam SmallRegister jungles::small_register template instance which defines the layout.
+ */
+template<typename SmallRegister>
+class atomic_small_register
+{
+  private:
+    using Register = typename SmallRegister::underlying_type;
+
+  public:
+    //! Type of the register which defines the layout.
+    using register_type = SmallRegister;
+
+    //! Type of the register value.
+    using underlying_type = Register;
+
+    //! True if the operations are lock-free on every instance, on the target.
+    static inline constexpr bool is_always_lock_free{std::atomic<Register>::is_always_lock_free};
+
+    constexpr atomic_small_register(SmallRegister initial_value = SmallRegister{}) : value{initial_value()}
+    {
+    }
+
+    atomic_small_register(const atomic_small_register&) = delete;
+    atomic_small_register& operator=(const atomic_small_register&) = delete;
+
+    SmallRegister load(std::memory_order order = std::memory_order_seq_cst) const
+    {
+        return SmallRegister{value.load(order)};
+    }
+
+    void store(SmallRegister reg, std::memory_order order = std::memory_order_seq_cst)
+    {
+        value.store(reg(), order);
+    }
+
+    SmallRegister exchange(SmallRegister reg, std::memory_order order = std::memory_order_seq_cst)
+    {
+        return SmallRegister{value.exchange(reg(), order)};
+    }
+
+    //! Returns the value of the specified bitfield, or a tuple of the values if multiple IDs are specified.
+    template<auto... Ids>
+    auto get(std::memory_order order = std::memory_order_seq_cst) const
+    {
+        return load(order).template get<Ids...>();
+    }
+
+    //! Sets all the bits of the bitfields, or the bitfield to the compile-time value, with a single fetch_or().
+    template<auto Id, auto... Ids>
+    SmallRegister set(std::memory_order order = std::memory_order_seq_cst)
+    {
+        SmallRegister bits{0};
+        bits.template set<Id, Ids...>();
+        return SmallRegister{value.fetch_or(bits(), order)};
+    }
+
+    //! ORs the values into the bitfields with a single fetch_or(). See basic_small_register::set(values).
+    template<auto... Ids>
+    auto set(typename detail::type_for<Register, Ids>::type... values,
+             std::memory_order order = std::memory_order_seq_cst)
+    {
+        return apply(SmallRegister{0},
+                     [&](auto& bits) -> decltype(auto) { return bits.template set<Ids...>(values...); },
+                     [&](Register bits) { return value.fetch_or(bits, order); });
+    }
+
+    //! Clears all the bits of the bitfields, or the compile-time mask, with a single fetch_and().
+    template<auto Id, auto... Ids>
+    SmallRegister clear(std::memory_order order = std::memory_order_seq_cst)
+    {
+        SmallRegister kept{static_cast<Register>(~Register{0})};
+        kept.template clear<Id, Ids...>();
+        return SmallRegister{value.fetch_and(kept(), order)};
+    }
+
+    //! Clears the bits of the masks with a single fetch_and(). See basic_small_register::clear(masks).
+    template<auto... Ids>
+    auto clear(typename detail::type_for<Register, Ids>::type... masks,
+               std::memory_order order = std::memory_order_seq_cst)
+    {
+        return apply(SmallRegister{static_cast<Register>(~Register{0})},
+                     [&](auto& kept) -> decltype(auto) { return kept.template clear<Ids...>(masks...); },
+                     [&](Register kept) { return value.fetch_and(kept, order); });
+    }
+
+    //! Assigns the compile-time value to the bitfield with a compare-exchange loop.
+    template<auto Id, auto Value>
+    SmallRegister assign(std::memory_order order = std::memory_order_seq_cst)
+    {
+        SmallRegister bits{0};
+        bits.template assign<Id, Value>();
+        return SmallRegister{replace(field_mask<Id>(), bits(), order)};
+    }
+
+    //! Assigns the values to the bitfields with a compare-exchange loop. See basic_small_register::assign(values).
+    template<auto... Ids>
+    auto assign(typename detail::type_for<Register, Ids>::type... values,
+                std::memory_order order = std::memory_order_seq_cst)
+    {
+        return apply(SmallRegister{0},
+                     [&](auto& bits) -> decltype(auto) { return bits.template assign<Ids...>(values...); },
+                     [&](Register bits) { return replace(field_mask<Ids...>(), bits, order); });
+    }
+
+    /**
+     * \brief Applies the function to a copy of the register and replaces the register with the result, atomically.
+     *
+     * The function may be called multiple times, when other threads modify the register concurrently, so it shall
+     * have no side effects. E.g. "r.modify([](auto& reg) { reg.template assign<id>(reg.template get<id>() + 1); });"
+     *
+     * \returns The register before the modification.
+     */
+    template<typename Function>
+    SmallRegister modify(Function function, std::memory_order order = std::memory_order_seq_cst)
+    {
+        auto expected{value.load(std::memory_order_relaxed)};
+        SmallRegister desired{expected};
+        do
+        {
+            desired = SmallRegister{expected};
+            function(desired);
+        } while (!value.compare_exchange_weak(expected, desired(), order, detail::failure_order(order)));
+        return SmallRegister{expected};
+    }
+
+  private:
+    //! Bits of the bitfields, computed without any operation on a register, which the tracer would record.
+    template<auto... Ids>
+    static constexpr Register field_mask()
+    {
+        return static_cast<Register>(
+            (Register{0} | ... | (SmallRegister::template mask<Ids>() << SmallRegister::template shift<Ids>())));
+    }
+
+    //! Replaces the bits under the mask with the bits, leaving the other bits untouched.
+    Register replace(Register mask, Register bits, std::memory_order order)
+    {
+        auto expected{value.load(std::memory_order_relaxed)};
+        while (!value.compare_exchange_weak(expected,
+                                            static_cast<Register>((expected & ~mask) | bits),
+                                            order,
+                                            detail::failure_order(order)))
+        {
+        }
+        return expected;
+    }
+
+    /**
+     * Computes the operand of the atomic operation by applying the operation to the initial register, which checks the
+     * values according to the overflow policy, and performs the atomic operation unless an error is returned.
+     */
+    template<typename Operation, typename AtomicOperation>
+    auto apply(SmallRegister operand, Operation operation, AtomicOperation atomic_operation)
+    {
+        if constexpr (std::is_same_v<decltype(operation(operand)), std::errc>)
+        {
+            auto result{operation(operand)};
+            if (result == std::errc{})
+                atomic_operation(operand());
+            return result;
+        } else
+        {
+            operation(operand);
+            return SmallRegister{atomic_operation(operand())};
+        }
+    }
+
+    std::atomic<Register> value;
+};
+
+} // namespace jungles
+
+#endif /* ATOMIC_SMALL_REGISTER_HPP */
@@ -0,0 +1,167 @@
+/**
+ * @file	byte_order.hpp
+ * @brief	Loads and stores registers from and to byte buffers, in big or little endian byte order.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef BYTE_ORDER_HPP
+#define BYTE_ORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <cstdlib>
+#endif
+
+namespace jungles
+{
+
+//! Order of the bytes of a multi-byte register within a buffer.
+enum class byte_order
+{
+    big,
+    little
+};
+
+namespace detail
+{
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && defined(__ORDER_BIG_ENDIAN__)
+inline constexpr bool is_host_order_known{__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                                          || __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__};
+inline constexpr byte_order host_order{__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ ? byte_order::big : byte_order::little};
+#elif defined(_MSC_VER)
+inline constexpr bool is_host_order_known{true};
+inline constexpr byte_order host_order{byte_order::little};
+#else
+inline constexpr bool is_host_order_known{false};
+inline constexpr byte_order host_order{byte_order::big};
+#endif
+
+template<typename Byte>
+inline constexpr bool is_byte{std::is_same_v<std::remove_cv_t<Byte>, uint8_t>
+                              || std::is_same_v<std::remove_cv_t<Byte>, unsigned char>
+                              || std::is_same_v<std::remove_cv_t<Byte>, char>
+                              || std::is_same_v<std::remove_cv_t<Byte>, std::byte>};
+
+//! Reverses the order of the bytes of the value, with a single instruction where the compiler provides an intrinsic.
+template<typename T>
+inline T byteswap(T value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (sizeof(T) == 2)
+        return static_cast<T>(__builtin_bswap16(static_cast<uint16_t>(value)));
+    else if constexpr (sizeof(T) == 4)
+        return static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(value)));
+    else if constexpr (sizeof(T) == 8)
+        return static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(value)));
+    else
+#elif defined(_MSC_VER)
+    if constexpr (sizeof(T) == 2)
+        return static_cast<T>(_byteswap_ushort(static_cast<unsigned short>(value)));
+    else if constexpr (sizeof(T) == 4)
+        return static_cast<T>(_byteswap_ulong(static_cast<unsigned long>(value)));
+    else if constexpr (sizeof(T) == 8)
+        return static_cast<T>(_byteswap_uint64(static_cast<unsigned long long>(value)));
+    else
+#endif
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+        auto bits{static_cast<Unsigned>(value)};
+        Unsigned result{0};
+        for (std::size_t i{0}; i < sizeof(T); ++i)
+        {
+            result = static_cast<Unsigned>((result << 8) | (bits & 0xFFu));
+            bits = static_cast<Unsigned>(bits >> 8);
+        }
+        return static_cast<T>(result);
+    }
+}
+
+//! Assembles the value from the bytes ordered as specified.
+template<byte_order Order, typename T>
+inline T load(const uint8_t* data)
+{
+    if constexpr (is_host_order_known)
+    {
+        T result;
+        std::memcpy(&result, data, sizeof(T));
+        return Order == host_order ? result : byteswap(result);
+    } else
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+        Unsigned result{0};
+        for (std::size_t i{0}; i < sizeof(T); ++i)
+        {
+            auto byte{data[Order == byte_order::big ? i : sizeof(T) - 1 - i]};
+            result = static_cast<Unsigned>((result << 8) | byte);
+        }
+        return static_cast<T>(result);
+    }
+}
+
+//! Stores the value as bytes ordered as specified.
+template<byte_order Order, typename T>
+inline void store(T value, uint8_t* data)
+{
+    if constexpr (is_host_order_known)
+    {
+        auto ordered{Order == host_order ? value : byteswap(value)};
+        std::memcpy(data, &ordered, sizeof(T));
+    } else
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+        auto bits{static_cast<Unsigned>(value)};
+        for (std::size_t i{sizeof(T)}; i > 0; --i)
+        {
+            data[Order == byte_order::big ? i - 1 : sizeof(T) - i] = static_cast<uint8_t>(bits);
+            bits = static_cast<Unsigned>(bits >> 8);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * \brief Constructs the register from sizeof(underlying_type) bytes, the most significant byte first.
+ * \tparam SmallRegister jungles::small_register template instance.
+ * \tparam Byte uint8_t, unsigned char, char or std::byte.
+ */
+template<typename SmallRegister, typename Byte>
+inline SmallRegister load_be(const Byte* data)
+{
+    static_assert(detail::is_byte<Byte>, "Registers can be loaded only from buffers of bytes");
+    return SmallRegister{detail::load<byte_order::big, typename SmallRegister::underlying_type>(
+        reinterpret_cast<const uint8_t*>(data))};
+}
+
+//! Constructs the register from sizeof(underlying_type) bytes, the least significant byte first.
+template<typename SmallRegister, typename Byte>
+inline SmallRegister load_le(const Byte* data)
+{
+    static_assert(detail::is_byte<Byte>, "Registers can be loaded only from buffers of bytes");
+    return SmallRegister{detail::load<byte_order::little, typename SmallRegister::underlying_type>(
+        reinterpret_cast<const uint8_t*>(data))};
+}
+
+//! Stores the value of the register as sizeof(underlying_type) bytes, the most significant byte first.
+template<typename SmallRegister, typename Byte>
+inline void store_be(const SmallRegister& reg, Byte* data)
+{
+    static_assert(detail::is_byte<Byte>, "Registers can be stored only to buffers of bytes");
+    detail::store<byte_order::big>(reg(), reinterpret_cast<uint8_t*>(data));
+}
+
+//! Stores the value of the register as sizeof(underlying_type) bytes, the least significant byte first.
+template<typename SmallRegister, typename Byte>
+inline void store_le(const SmallRegister& reg, Byte* data)
+{
+    static_assert(detail::is_byte<Byte>, "Registers can be stored only to buffers of bytes");
+    detail::store<byte_order::little>(reg(), reinterpret_cast<uint8_t*>(data));
+}
+
+} // namespace jungles
+
+#endif /* BYTE_ORDER_HPP */
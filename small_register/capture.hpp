@@ -0,0 +1,479 @@
+/**
+ * @file	capture.hpp
+ * @brief	Decodes captures of register traffic, e.g. memory-mapped files of tens of gigabytes, in parallel through a
+ *          small_map. The registers of the map shall be at most 32 bits wide, as the values of the records are.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef CAPTURE_HPP
+#define CAPTURE_HPP
+
+#include "small_register/small_map.hpp"
+#include "small_register/small_register_batch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jungles
+{
+
+/**
+ * \brief Record of a capture: the raw value of the register under the address, observed on the bus at the timestamp.
+ *
+ * Capture files are arrays of the records, in the byte order of the host, without any header. The value holds 32 bits,
+ * so the maps with wider registers are rejected at compile time.
+ */
+struct capture_record
+{
+    std::uint64_t timestamp;
+    std::uint32_t address;
+    std::uint32_t value;
+};
+
+static_assert(sizeof(capture_record) == 16, "Capture records shall have no padding");
+
+namespace detail
+{
+
+//! Number of the records decoded by a thread at once, 1 MiB, so that the threads rarely contend for the chunks.
+inline constexpr std::size_t capture_chunk_size{std::size_t{1} << 16};
+
+template<typename... Elements>
+constexpr bool fit_capture_record(std::tuple<Elements...>*)
+{
+    return ((sizeof(typename Elements::Register::underlying_type) <= sizeof(capture_record::value)) && ...);
+}
+
+//! Whether all the registers of the map fit the value of jungles::capture_record.
+template<typename Map>
+inline constexpr bool fits_capture_record{fit_capture_record(static_cast<typename Map::elements*>(nullptr))};
+
+inline std::size_t chunk_count(const capture_record* first, const capture_record* last)
+{
+    return (static_cast<std::size_t>(last - first) + capture_chunk_size - 1) / capture_chunk_size;
+}
+
+/**
+ * \brief Calls function(chunk, first, last) for each chunk of the records, on the threads, which take the next chunk
+ *        as soon as they finish the previous one.
+ *
+ * The calling thread is one of the threads. The first exception thrown by the function is rethrown, after the
+ * remaining chunks are abandoned.
+ */
+template<typename Function>
+void for_each_chunk(const capture_record* first, const capture_record* last, unsigned threads, Function function)
+{
+    const auto count{static_cast<std::size_t>(last - first)};
+    const auto chunks{chunk_count(first, last)};
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(chunks, 1)));
+
+    std::atomic<std::size_t> next{0};
+    std::vector<std::exception_ptr> errors(threads);
+    auto work{[&](unsigned thread) {
+        try
+        {
+            for (auto chunk{next.fetch_add(1, std::memory_order_relaxed)}; chunk < chunks;
+                 chunk = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                auto chunk_first{chunk * capture_chunk_size};
+                auto chunk_last{std::min(count, chunk_first + capture_chunk_size)};
+                function(chunk, first + chunk_first, first + chunk_last);
+            }
+        } catch (...)
+        {
+            errors[thread] = std::current_exception();
+            next.store(chunks, std::memory_order_relaxed);
+        }
+    }};
+
+    std::vector<std::thread> workers;
+    for (unsigned thread{1}; thread < threads; ++thread)
+        workers.emplace_back(work, thread);
+    work(0);
+    for (auto& worker : workers)
+        worker.join();
+
+    for (auto& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+//! Calls the function with the timestamp prepended to the arguments passed by small_map::visit().
+template<typename Function>
+struct timestamped
+{
+    // SFINAE lets small_map::visit() detect whether the function accepts the jungles::element.
+    template<typename... Arguments>
+    auto operator()(Arguments... arguments)
+        -> decltype(std::declval<Function&>()(std::uint64_t{}, arguments...), void())
+    {
+        if constexpr (std::is_same_v<decltype(function(timestamp, arguments...)), bool>)
+            result = function(timestamp, arguments...);
+        else
+            function(timestamp, arguments...);
+    }
+
+    Function& function;
+    std::uint64_t timestamp;
+    bool result{false};
+};
+
+//! Returns the result of the function when it returns bool; false when there is no register under the address.
+template<typename Map, typename Function>
+bool visit_record(const capture_record& record, Function& function)
+{
+    using Address = typename Map::address_type;
+    auto address{static_cast<Address>(record.address)};
+    // The addresses which don't fit the address type of the map would otherwise alias the addresses of the map.
+    if (static_cast<std::uint32_t>(address) != record.address)
+        return false;
+
+    timestamped<Function> visitor{function, record.timestamp};
+    Map::visit(address, record.value, visitor);
+    return visitor.result;
+}
+
+//! Leaves the elements uninitialized when resizing, so that the output arrays are not zeroed by a single thread.
+template<typename T>
+struct uninitialized_allocator : std::allocator<T>
+{
+    template<typename U>
+    struct rebind
+    {
+        using other = uninitialized_allocator<U>;
+    };
+
+    uninitialized_allocator() = default;
+
+    template<typename U>
+    uninitialized_allocator(const uninitialized_allocator<U>&) noexcept
+    {
+    }
+
+    template<typename U>
+    void construct(U* p)
+    {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template<typename U, typename... Arguments>
+    void construct(U* p, Arguments&&... arguments)
+    {
+        ::new (static_cast<void*>(p)) U(std::forward<Arguments>(arguments)...);
+    }
+};
+
+} // namespace detail
+
+#if __has_include(<sys/mman.h>)
+
+/**
+ * \brief Read-only view of a capture file mapped into memory, so that the records are paged in on demand, and the
+ *        files larger than the memory can be decoded.
+ *
+ * \throws std::system_error when the file can't be opened or mapped, or with std::errc::invalid_argument when the
+ *         size of the file isn't a multiple of the size of jungles::capture_record.
+ */
+class mapped_capture
+{
+  public:
+    explicit mapped_capture(const char* path)
+    {
+        auto descriptor{::open(path, O_RDONLY | O_CLOEXEC)};
+        if (descriptor == -1)
+            throw std::system_error{errno, std::generic_category(), path};
+
+        auto fail{[&](std::error_code error) {
+            ::close(descriptor);
+            throw std::system_error{error, path};
+        }};
+
+        struct ::stat status
+        {
+        };
+        if (::fstat(descriptor, &status) == -1)
+            fail({errno, std::generic_category()});
+        auto bytes{static_cast<std::size_t>(status.st_size)};
+        if (bytes % sizeof(capture_record) != 0)
+            fail(std::make_error_code(std::errc::invalid_argument));
+
+        if (bytes != 0)
+        {
+            auto memory{::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, descriptor, 0)};
+            if (memory == MAP_FAILED)
+                fail({errno, std::generic_category()});
+            // Each thread reads its chunk sequentially, so an aggressive read-ahead pays off.
+            ::madvise(memory, bytes, MADV_SEQUENTIAL);
+            data = memory;
+            count = bytes / sizeof(capture_record);
+        }
+        ::close(descriptor);
+    }
+
+    mapped_capture(mapped_capture&& other) noexcept :
+        data{std::exchange(other.data, nullptr)}, count{std::exchange(other.count, 0)}
+    {
+    }
+
+    mapped_capture& operator=(mapped_capture&& other) noexcept
+    {
+        std::swap(data, other.data);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    ~mapped_capture()
+    {
+        if (data != nullptr)
+            ::munmap(data, count * sizeof(capture_record));
+    }
+
+    const capture_record* begin() const
+    {
+        return static_cast<const capture_record*>(data);
+    }
+
+    const capture_record* end() const
+    {
+        return begin() + count;
+    }
+
+    //! Number of the records.
+    std::size_t size() const
+    {
+        return count;
+    }
+
+  private:
+    void* data{nullptr};
+    std::size_t count{0};
+};
+
+#endif
+
+//! Array of the values of a single bitfield, or of the timestamps, extracted from a capture.
+template<typename T>
+using capture_column = std::vector<T, detail::uninitialized_allocator<T>>;
+
+//! The register under a single address, decoded from a capture into a column for each bitfield.
+template<typename SmallRegister>
+struct capture_columns
+{
+    capture_column<std::uint64_t> timestamps;
+    //! The values of the bitfields in the order of declaration, as basic_small_register::get() returns them.
+    std::array<capture_column<typename SmallRegister::underlying_type>, SmallRegister::bitfield_count> fields;
+};
+
+/**
+ * \brief Calls a copy of the visitor for each chunk of the capture, on the threads, and returns the copies in the
+ *        order of the chunks, to be merged by the caller.
+ *
+ * The visitor is called for each record with the timestamp and the register, decoded as small_map::visit() does, e.g.
+ * "visitor(std::uint64_t timestamp, Status status)", or with the timestamp, the jungles::element and the register.
+ * The records with the addresses which aren't in the Map are skipped. The chunks are contiguous, so each copy visits
+ * its records in the order of the capture.
+ *
+ * \param threads Number of the threads, or 0 for the number of the hardware threads.
+ */
+template<typename Map, typename Visitor>
+std::vector<Visitor>
+decode(const capture_record* first, const capture_record* last, const Visitor& visitor, unsigned threads = 0)
+{
+    static_assert(detail::fits_capture_record<Map>, "Registers of the map must be at most 32 bits wide");
+    std::vector<std::optional<Visitor>> visitors(detail::chunk_count(first, last));
+    detail::for_each_chunk(first, last, threads, [&](std::size_t chunk, auto chunk_first, auto chunk_last) {
+        // A local copy keeps the state of the visitors of the neighbouring chunks out of the same cache line.
+        auto local{visitor};
+        for (; chunk_first != chunk_last; ++chunk_first)
+            detail::visit_record<Map>(*chunk_first, local);
+        visitors[chunk].emplace(std::move(local));
+    });
+
+    std::vector<Visitor> result;
+    result.reserve(visitors.size());
+    for (auto& v : visitors)
+        result.push_back(std::move(*v));
+    return result;
+}
+
+/**
+ * \brief Extracts the bitfields of the register under the Address into the columns, in the order of the capture.
+ *
+ * The records of each chunk are counted first, so that the threads write the columns in place, without merging.
+ * The bitfields are extracted with jungles::unpack_all().
+ */
+template<typename Map, auto Address>
+capture_columns<typename Map::template register_from_address<Address>::type>
+columns(const capture_record* first, const capture_record* last, unsigned threads = 0)
+{
+    static_assert(detail::fits_capture_record<Map>, "Registers of the map must be at most 32 bits wide");
+    using SmallRegister = typename Map::template register_from_address<Address>::type;
+    using Raw = typename SmallRegister::underlying_type;
+    constexpr auto address{static_cast<std::uint32_t>(Address)};
+
+    std::vector<std::size_t> offsets(detail::chunk_count(first, last) + 1, 0);
+    detail::for_each_chunk(first, last, threads, [&](std::size_t chunk, auto chunk_first, auto chunk_last) {
+        offsets[chunk + 1] = static_cast<std::size_t>(
+            std::count_if(chunk_first, chunk_last, [](const auto& record) { return record.address == address; }));
+    });
+    for (std::size_t chunk{1}; chunk < offsets.size(); ++chunk)
+        offsets[chunk] += offsets[chunk - 1];
+
+    capture_columns<SmallRegister> result;
+    result.timestamps.resize(offsets.back());
+    for (auto& field : result.fields)
+        field.resize(offsets.back());
+
+    detail::for_each_chunk(first, last, threads, [&](std::size_t chunk, auto chunk_first, auto chunk_last) {
+        auto offset{offsets[chunk]};
+        capture_column<Raw> raw(offsets[chunk + 1] - offset);
+        std::size_t i{0};
+        for (; chunk_first != chunk_last; ++chunk_first)
+        {
+            if (chunk_first->address == address)
+            {
+                result.timestamps[offset + i] = chunk_first->timestamp;
+                raw[i++] = static_cast<Raw>(chunk_first->value);
+            }
+        }
+
+        std::array<Raw*, SmallRegister::bitfield_count> outputs;
+        for (std::size_t field{0}; field < outputs.size(); ++field)
+            outputs[field] = result.fields[field].data() + offset;
+        unpack_all<SmallRegister>(raw.data(), raw.data() + raw.size(), outputs);
+    });
+    return result;
+}
+
+/**
+ * \brief Returns the records for which the predicate returns true, in the order of the capture.
+ *
+ * The predicate is called as the visitor of jungles::decode(), e.g. "[](std::uint64_t, Status s) { return
+ * s.get<status::chg_stat>() == 3; }", and shall return false for the registers it isn't interested in. Each chunk is
+ * filtered with a separate copy of the predicate.
+ */
+template<typename Map, typename Predicate>
+std::vector<capture_record>
+filter(const capture_record* first, const capture_record* last, const Predicate& predicate, unsigned threads = 0)
+{
+    static_assert(detail::fits_capture_record<Map>, "Registers of the map must be at most 32 bits wide");
+    std::vector<std::vector<capture_record>> matches(detail::chunk_count(first, last));
+    detail::for_each_chunk(first, last, threads, [&](std::size_t chunk, auto chunk_first, auto chunk_last) {
+        auto local{predicate};
+        for (; chunk_first != chunk_last; ++chunk_first)
+            if (detail::visit_record<Map>(*chunk_first, local))
+                matches[chunk].push_back(*chunk_first);
+    });
+
+    std::size_t size{0};
+    for (const auto& chunk : matches)
+        size += chunk.size();
+    std::vector<capture_record> result;
+    result.reserve(size);
+    for (const auto& chunk : matches)
+        result.insert(result.end(), chunk.begin(), chunk.end());
+    return result;
+}
+
+/**
+ * \brief Generates synthetic captures of the registers of the Map, for tests and benchmarks.
+ *
+ * The addresses are chosen uniformly from the Map, the values are random within the size of the registers and the
+ * timestamps increase by 1 to 16. The same seed gives the same capture on every platform.
+ */
+template<typename Map>
+class capture_generator
+{
+    static_assert(detail::fits_capture_record<Map>, "Registers of the map must be at most 32 bits wide");
+
+  public:
+    explicit capture_generator(std::uint64_t seed = 0) : engine{seed}
+    {
+    }
+
+    capture_record operator()()
+    {
+        auto position{static_cast<std::size_t>(engine() % Map::size)};
+        timestamp += 1 + engine() % 16;
+        return {timestamp, addresses[position], static_cast<std::uint32_t>(engine() & masks[position])};
+    }
+
+    void generate(capture_record* first, capture_record* last)
+    {
+        for (; first != last; ++first)
+            *first = (*this)();
+    }
+
+    /**
+     * \brief Writes count records to the file, in chunks, so that the captures larger than the memory can be
+     *        generated.
+     *
+     * \throws std::system_error when the file can't be written.
+     */
+    void generate(const char* path, std::size_t count)
+    {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{std::fopen(path, "wb"), &std::fclose};
+        if (!file)
+            throw std::system_error{errno, std::generic_category(), path};
+
+        std::vector<capture_record> chunk(detail::capture_chunk_size);
+        while (count != 0)
+        {
+            auto size{std::min(count, chunk.size())};
+            generate(chunk.data(), chunk.data() + size);
+            if (std::fwrite(chunk.data(), sizeof(capture_record), size, file.get()) != size)
+                throw std::system_error{errno, std::generic_category(), path};
+            count -= size;
+        }
+        if (std::fclose(file.release()) != 0)
+            throw std::system_error{errno, std::generic_category(), path};
+    }
+
+  private:
+    template<typename... Elements>
+    static constexpr std::array<std::uint32_t, sizeof...(Elements)> make_addresses(std::tuple<Elements...>*)
+    {
+        return {static_cast<std::uint32_t>(Elements::address)...};
+    }
+
+    template<typename... Elements>
+    static constexpr std::array<std::uint32_t, sizeof...(Elements)> make_masks(std::tuple<Elements...>*)
+    {
+        return {static_cast<std::uint32_t>(
+            std::numeric_limits<typename Elements::Register::underlying_type>::max())...};
+    }
+
+    static inline constexpr auto addresses{make_addresses(static_cast<typename Map::elements*>(nullptr))};
+    static inline constexpr auto masks{make_masks(static_cast<typename Map::elements*>(nullptr))};
+
+    std::mt19937_64 engine;
+    std::uint64_t timestamp{0};
+};
+
+} // namespace jungles
+
+#endif /* CAPTURE_HPP */
@@ -0,0 +1,234 @@
+/**
+ * @file	deferred.hpp
+ * @brief	Chains of operations on a register folded into a single mask and value, committed with a single access.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef DEFERRED_HPP
+#define DEFERRED_HPP
+
+#include "small_register/atomic_small_register.hpp"
+#include "small_register/mmio_register.hpp"
+#include "small_register/small_register.hpp"
+#include "small_register/small_register_internal.hpp"
+
+#include <exception>
+#include <system_error>
+#include <type_traits>
+
+namespace jungles
+{
+
+namespace detail
+{
+
+//! The jungles::basic_small_register which defines the layout of the target of jungles::deferred.
+template<typename Target>
+struct register_of
+{
+    using type = typename Target::register_type;
+};
+
+template<typename OverflowPolicy, typename Register, typename... Bitfields>
+struct register_of<basic_small_register<OverflowPolicy, Register, Bitfields...>>
+{
+    using type = basic_small_register<OverflowPolicy, Register, Bitfields...>;
+};
+
+//! Replaces the register with "(register & keep) | bits".
+template<typename OverflowPolicy, typename Register, typename... Bitfields>
+void commit(basic_small_register<OverflowPolicy, Register, Bitfields...>& target, Register keep, Register bits)
+{
+    target = basic_small_register<OverflowPolicy, Register, Bitfields...>{
+        static_cast<Register>((target() & keep) | bits)};
+}
+
+/**
+ * \brief A single read-modify-write, or a single store when no read-write bit of the register is kept.
+ *
+ * Without the load the write-1-to-clear bits are assumed set, so that only the cleared ones are written as ones. The
+ * read-modify-write is mmio_register::modify(), which zeroes the write-only bits loaded.
+ */
+template<typename SmallRegister, typename Access, typename Register>
+void commit(mmio_register<SmallRegister, Access>& target, Register keep, Register bits)
+{
+    constexpr auto flags{SmallRegister::template access_mask<field_access::write_1_to_clear>};
+    constexpr auto preserved{SmallRegister::template access_mask<field_access::read_write>};
+    if ((keep & preserved) == 0)
+        target.write(SmallRegister{
+            SmallRegister::written_value(flags, static_cast<Register>((flags & keep) | bits))});
+    else
+        target.modify([&](auto& reg) { reg = SmallRegister{static_cast<Register>((reg() & keep) | bits)}; });
+}
+
+//! A compare-exchange loop, as atomic_small_register::modify().
+template<typename SmallRegister, typename Register>
+void commit(atomic_small_register<SmallRegister>& target, Register keep, Register bits)
+{
+    target.modify([&](auto& reg) { reg = SmallRegister{static_cast<Register>((reg() & keep) | bits)}; });
+}
+
+} // namespace detail
+
+/**
+ * \brief Accumulates the operations on the Target into an AND-mask and an OR-value, and commits them with a single
+ *        access, on apply() or when destroyed.
+ *
+ * Created with jungles::defer(). Makes the chains perform a single access to slow storage, e.g. a volatile
+ * jungles::mmio_register or a jungles::atomic_small_register, without changing the chains:
+ *
+ *     defer(gpio).set<gpio::enable>().clear<gpio::mode>().set<gpio::prescaler>(x); // One read-modify-write
+ *
+ * The result is the same as of the chain performed directly on the Target. The values are checked according to the
+ * overflow policy when each operation is called. Nothing is committed when an exception is thrown. Under
+ * jungles::overflow::return_error a failed operation returns the error code and isn't accumulated.
+ *
+ * \note The expression refers to the Target, so it shall not outlive it.
+ *
+ * \tparam Target jungles::basic_small_register, jungles::mmio_register or jungles::atomic_small_register.
+ */
+template<typename Target>
+class deferred
+{
+  private:
+    using SmallRegister = typename detail::register_of<Target>::type;
+    using Register = typename SmallRegister::underlying_type;
+
+    static inline constexpr Register all_ones{static_cast<Register>(~Register{0})};
+
+  public:
+    explicit deferred(Target& target) : target{target}, uncaught_exceptions{std::uncaught_exceptions()}
+    {
+    }
+
+    deferred(const deferred&) = delete;
+    deferred& operator=(const deferred&) = delete;
+
+    ~deferred()
+    {
+        if (std::uncaught_exceptions() == uncaught_exceptions)
+            apply();
+    }
+
+    //! See basic_small_register::set().
+    template<auto Id, auto... Ids>
+    deferred& set()
+    {
+        SmallRegister operand{0};
+        operand.template set<Id, Ids...>();
+        // The bits which are set needn't be kept, what lets the compiler merge the masks.
+        return accumulate(static_cast<Register>(~operand()), operand());
+    }
+
+    //! See basic_small_register::set(values).
+    template<auto... Ids>
+    decltype(auto) set(typename detail::type_for<Register, Ids>::type... values)
+    {
+        return accumulate(
+            SmallRegister{0},
+            [&](auto& operand) -> decltype(auto) { return operand.template set<Ids...>(values...); },
+            [&](Register operand) -> deferred& { return accumulate(all_ones, operand); });
+    }
+
+    //! See basic_small_register::assign().
+    template<auto Id, auto Value>
+    deferred& assign()
+    {
+        SmallRegister operand{0};
+        operand.template assign<Id, Value>();
+        return accumulate(static_cast<Register>(~field_mask<Id>()), operand());
+    }
+
+    //! See basic_small_register::assign(values).
+    template<auto... Ids>
+    decltype(auto) assign(typename detail::type_for<Register, Ids>::type... values)
+    {
+        return accumulate(
+            SmallRegister{0},
+            [&](auto& operand) -> decltype(auto) { return operand.template assign<Ids...>(values...); },
+            [&](Register operand) -> deferred& {
+                return accumulate(static_cast<Register>(~field_mask<Ids...>()), operand);
+            });
+    }
+
+    //! See basic_small_register::clear().
+    template<auto Id, auto... Ids>
+    deferred& clear()
+    {
+        SmallRegister kept{all_ones};
+        kept.template clear<Id, Ids...>();
+        return accumulate(kept(), 0);
+    }
+
+    //! See basic_small_register::clear(masks).
+    template<auto... Ids>
+    decltype(auto) clear(typename detail::type_for<Register, Ids>::type... masks)
+    {
+        return accumulate(
+            SmallRegister{all_ones},
+            [&](auto& kept) -> decltype(auto) { return kept.template clear<Ids...>(masks...); },
+            [&](Register kept) -> deferred& { return accumulate(kept, 0); });
+    }
+
+    //! Commits the accumulated operations to the Target with a single access, if there are any.
+    void apply()
+    {
+        if (!is_pending)
+            return;
+        detail::commit(target, keep, bits);
+        keep = all_ones;
+        bits = 0;
+        is_pending = false;
+    }
+
+  private:
+    //! Bits of the bitfields, computed without any operation on a register, which the tracer would record.
+    template<auto... Ids>
+    static constexpr Register field_mask()
+    {
+        return static_cast<Register>(
+            (Register{0} | ... | (SmallRegister::template mask<Ids>() << SmallRegister::template shift<Ids>())));
+    }
+
+    //! Composes "x = (x & keep) | bits" with "x = (x & operand_keep) | operand_bits".
+    deferred& accumulate(Register operand_keep, Register operand_bits)
+    {
+        keep = static_cast<Register>(keep & operand_keep);
+        bits = static_cast<Register>((bits & operand_keep) | operand_bits);
+        is_pending = true;
+        return *this;
+    }
+
+    //! Checks the values according to the overflow policy, as atomic_small_register does, before accumulating them.
+    template<typename Operation, typename Accumulation>
+    decltype(auto) accumulate(SmallRegister operand, Operation operation, Accumulation accumulation)
+    {
+        if constexpr (std::is_same_v<decltype(operation(operand)), std::errc>)
+        {
+            auto result{operation(operand)};
+            if (result == std::errc{})
+                accumulation(operand());
+            return result;
+        } else
+        {
+            operation(operand);
+            return accumulation(operand());
+        }
+    }
+
+    Target& target;
+    int uncaught_exceptions;
+    Register keep{all_ones};
+    Register bits{0};
+    bool is_pending{false};
+};
+
+//! Starts a chain of operations on the target which is committed with a single access. See jungles::deferred.
+template<typename Target>
+deferred<Target> defer(Target& target)
+{
+    return deferred<Target>{target};
+}
+
+} // namespace jungles
+
+#endif /* DEFERRED_HPP */
@@ -0,0 +1,171 @@
+/**
+ * @file	field_counters.hpp
+ * @brief	Tracer of jungles::instrumented registers which counts the operations on each bitfield.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FIELD_COUNTERS_HPP
+#define FIELD_COUNTERS_HPP
+
+#include "small_register/small_register_policies.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+namespace jungles
+{
+
+//! Number of the operations of each kind performed on a bitfield, or on a register of jungles::small_map.
+struct field_counts
+{
+    std::uint64_t reads;
+    std::uint64_t sets;
+    std::uint64_t clears;
+    std::uint64_t assigns;
+    std::uint64_t overflows;
+};
+
+//! Storage of the jungles::field_counters.
+namespace counting
+{
+
+//! Counters shared by all the threads, incremented with relaxed atomic operations.
+struct relaxed_atomic
+{
+    using counter = std::atomic<std::uint64_t>;
+
+    static void increment(counter& c)
+    {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static std::uint64_t load(const counter& c)
+    {
+        return c.load(std::memory_order_relaxed);
+    }
+};
+
+//! Separate counters for each thread, incremented without synchronization. A snapshot shows the calling thread only.
+struct per_thread
+{
+    using counter = std::uint64_t;
+
+    static void increment(counter& c)
+    {
+        ++c;
+    }
+
+    static std::uint64_t load(const counter& c)
+    {
+        return c;
+    }
+};
+
+} // namespace counting
+
+namespace detail
+{
+
+template<typename Owner, typename = void>
+inline constexpr bool is_map{false};
+
+template<typename Owner>
+inline constexpr bool is_map<Owner, std::void_t<typename Owner::elements>>{true};
+
+//! Number of the bitfields of the register, or of the registers of the map.
+template<typename Owner>
+constexpr std::size_t counted_slots()
+{
+    if constexpr (is_map<Owner>)
+        return Owner::size;
+    else
+        return Owner::bitfield_count;
+}
+
+} // namespace detail
+
+/**
+ * \brief Tracer for jungles::instrumented, which counts the operations on each bitfield of each register type.
+ *
+ * The counters are kept per register type, not per register object, so all the registers of the same type, e.g. the
+ * registers read from multiple devices, share them. Each jungles::small_map has its own counters, indexed with the
+ * position of the register within the map, where jungles::access::read counts reads over the transport, and
+ * jungles::access::assign counts writes; only the registers with the instrumented policy are counted.
+ *
+ * \tparam Storage counting::relaxed_atomic or counting::per_thread.
+ */
+template<typename Storage = counting::relaxed_atomic>
+struct field_counters
+{
+  private:
+    static inline constexpr std::size_t access_kinds{static_cast<std::size_t>(access::overflow) + 1};
+
+    template<typename Owner>
+    using table = std::array<std::array<typename Storage::counter, access_kinds>, detail::counted_slots<Owner>()>;
+
+    template<typename Owner>
+    static table<Owner>& counters()
+    {
+        if constexpr (std::is_same_v<Storage, counting::per_thread>)
+        {
+            static thread_local table<Owner> result{};
+            return result;
+        } else
+        {
+            static table<Owner> result{};
+            return result;
+        }
+    }
+
+  public:
+    //! Called by the jungles::instrumented registers and by jungles::small_map.
+    template<typename Owner, auto Id>
+    static void record(access operation)
+    {
+        constexpr auto position{Owner::template position<Id>()};
+        Storage::increment(counters<Owner>()[position][static_cast<std::size_t>(operation)]);
+    }
+
+    //! Returns the counters of the register type, indexed with the position of the bitfield in order of declaration.
+    template<typename Owner>
+    static std::array<field_counts, detail::counted_slots<Owner>()> snapshot()
+    {
+        std::array<field_counts, detail::counted_slots<Owner>()> result{};
+        auto& source{counters<Owner>()};
+        for (std::size_t i{0}; i < result.size(); ++i)
+        {
+            auto count{[&](access operation) {
+                return Storage::load(source[i][static_cast<std::size_t>(operation)]);
+            }};
+            result[i] = {count(access::read),
+                         count(access::set),
+                         count(access::clear),
+                         count(access::assign),
+                         count(access::overflow)};
+        }
+        return result;
+    }
+
+    //! Returns the counters of the single bitfield, or of the register under the address of the map.
+    template<typename Owner, auto Id>
+    static field_counts snapshot()
+    {
+        return snapshot<Owner>()[Owner::template position<Id>()];
+    }
+
+    //! Zeroes the counters of the register type.
+    template<typename Owner>
+    static void reset()
+    {
+        for (auto& field : counters<Owner>())
+            for (auto& counter : field)
+                counter = 0;
+    }
+};
+
+} // namespace jungles
+
+#endif /* FIELD_COUNTERS_HPP */
@@ -0,0 +1,285 @@
+/**
+ * @file	format.hpp
+ * @brief	Formats the registers, and the snapshots of whole maps, to text, JSON or CSV without allocations.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FORMAT_HPP
+#define FORMAT_HPP
+
+#include "small_register/register_file.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include <charconv>
+#include <ratio>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+
+namespace jungles
+{
+
+/**
+ * \brief Output formats of jungles::format():
+ * - text: "icc=20 en_ntc=1 ipre=1",
+ * - json: "{"icc":20,"en_ntc":1,"ipre":1}",
+ * - csv: "20,1,1", with the header "icc,en_ntc,ipre" written by jungles::format_header().
+ *
+ * Registers of a map are prefixed with the addresses in hexadecimal: "0x1: icc=20 ...; 0x5: ...",
+ * "{"0x1":{"icc":20,...},"0x5":{...}}" and "0x1.icc,...,0x5.chg,..." in the CSV header.
+ */
+enum class format_style
+{
+    text,
+    json,
+    csv
+};
+
+namespace detail
+{
+
+//! Writes to the buffer of the caller, as std::to_chars() does, remembering whether the buffer was too small.
+class format_output
+{
+  public:
+    format_output(char* first, char* last) : next{first}, last{last}
+    {
+    }
+
+    void put(char c)
+    {
+        if (next == last)
+            is_truncated = true;
+        else
+            *next++ = c;
+    }
+
+    void put(const char* text)
+    {
+        for (; *text != '\0'; ++text)
+            put(*text);
+    }
+
+    template<typename T>
+    void put_number(T value, int base = 10)
+    {
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<T>)
+            result = std::to_chars(next, last, value);
+        else
+            result = std::to_chars(next, last, value, base);
+
+        if (result.ec != std::errc{})
+        {
+            is_truncated = true;
+            next = last;
+        } else
+        {
+            next = result.ptr;
+        }
+    }
+
+    std::to_chars_result result() const
+    {
+        if (is_truncated)
+            return {last, std::errc::value_too_large};
+        return {next, std::errc{}};
+    }
+
+  private:
+    char* next;
+    char* last;
+    bool is_truncated{false};
+};
+
+template<typename T>
+constexpr auto to_integer(T value)
+{
+    if constexpr (std::is_enum_v<T>)
+        return static_cast<std::underlying_type_t<T>>(value);
+    else
+        return value;
+}
+
+template<typename Bitfield>
+void put_name(format_output& output)
+{
+    if constexpr (Bitfield::name != nullptr)
+        output.put(Bitfield::name);
+    else
+        output.put_number(to_integer(Bitfield::id));
+}
+
+//! The raw value, sign-extended for the signed bitfields, or the physical value for the scaled bitfields.
+template<typename Bitfield, typename SmallRegister>
+void put_value(format_output& output, const SmallRegister& reg)
+{
+    constexpr bool is_scaled{!std::ratio_equal_v<typename Bitfield::scale, std::ratio<1>>
+                             || !std::ratio_equal_v<typename Bitfield::offset, std::ratio<0>>};
+
+#if defined(__cpp_lib_to_chars)
+    if constexpr (is_scaled)
+    {
+        output.put_number(reg.template get_as<Bitfield::id, double>());
+        return;
+    }
+#endif
+    if constexpr (Bitfield::is_signed && !is_scaled)
+        output.put_number(reg.template get_as<Bitfield::id, long long>());
+    else
+        output.put_number(reg.template get<Bitfield::id>());
+}
+
+template<format_style Style, typename SmallRegister, typename... Bitfields>
+void put_register(format_output& output, const SmallRegister& reg, std::tuple<Bitfields...>*)
+{
+    bool is_first{true};
+    auto separate{[&]() {
+        if (!is_first)
+            output.put(Style == format_style::text ? ' ' : ',');
+        is_first = false;
+    }};
+
+    if constexpr (Style == format_style::json)
+        output.put('{');
+    (
+        [&]() {
+            separate();
+            if constexpr (Style == format_style::text)
+            {
+                put_name<Bitfields>(output);
+                output.put('=');
+            } else if constexpr (Style == format_style::json)
+            {
+                output.put('"');
+                put_name<Bitfields>(output);
+                output.put("\":");
+            }
+            put_value<Bitfields>(output, reg);
+        }(),
+        ...);
+    if constexpr (Style == format_style::json)
+        output.put('}');
+}
+
+//! Writes the address in hexadecimal, as its unsigned bit pattern, so that a negative address isn't written as "0x-5".
+template<typename Address>
+void put_address(format_output& output, Address address)
+{
+    using Integer = decltype(to_integer(address));
+    output.put("0x");
+    output.put_number(static_cast<std::make_unsigned_t<Integer>>(to_integer(address)), 16);
+}
+
+//! Writes the names of the bitfields, separated with commas, each preceded by the prefix written by put_prefix().
+template<typename... Bitfields, typename Prefix>
+void put_header(format_output& output, std::tuple<Bitfields...>*, Prefix put_prefix)
+{
+    bool is_first{true};
+    (
+        [&]() {
+            if (!is_first)
+                output.put(',');
+            is_first = false;
+            put_prefix();
+            put_name<Bitfields>(output);
+        }(),
+        ...);
+}
+
+template<typename SmallRegister>
+void put_header(format_output& output, SmallRegister*)
+{
+    put_header(output, static_cast<typename SmallRegister::bitfields*>(nullptr), []() {});
+}
+
+template<typename... Elements>
+void put_header(format_output& output, register_file<small_map<Elements...>>*)
+{
+    bool is_first{true};
+    (
+        [&]() {
+            if (!is_first)
+                output.put(',');
+            is_first = false;
+            put_header(output, static_cast<typename Elements::Register::bitfields*>(nullptr), [&]() {
+                put_address(output, Elements::address);
+                output.put('.');
+            });
+        }(),
+        ...);
+}
+
+} // namespace detail
+
+/**
+ * \brief Writes the names and the values of the bitfields to the buffer [first, last), e.g. "icc=20 en_ntc=1 ipre=1".
+ *
+ * Nothing is allocated: the numbers are written with std::to_chars(). No terminating '\0' is written. The names are
+ * the Name parameters of jungles::bitfield, or the numeric IDs. The signed bitfields are written as negative numbers
+ * when negative, and the scaled bitfields as the physical values, when the standard library supports std::to_chars()
+ * for floating-point numbers.
+ *
+ * \returns As std::to_chars(): the end of the written characters, or last and std::errc::value_too_large when the
+ *          buffer is too small, in which case the contents of the buffer are unspecified.
+ */
+template<format_style Style = format_style::text, typename OverflowPolicy, typename Register, typename... Bitfields>
+std::to_chars_result format(char* first,
+                            char* last,
+                            const basic_small_register<OverflowPolicy, Register, Bitfields...>& reg)
+{
+    detail::format_output output{first, last};
+    detail::put_register<Style>(output, reg, static_cast<std::tuple<Bitfields...>*>(nullptr));
+    return output.result();
+}
+
+//! Writes all the registers of the snapshot of a jungles::small_map, in the order of the map. See format(register).
+template<format_style Style = format_style::text, typename... Elements>
+std::to_chars_result format(char* first, char* last, const register_file<small_map<Elements...>>& registers)
+{
+    detail::format_output output{first, last};
+    bool is_first{true};
+    if constexpr (Style == format_style::json)
+        output.put('{');
+    (
+        [&]() {
+            if (!is_first)
+                output.put(Style == format_style::text ? "; " : ",");
+            is_first = false;
+
+            if constexpr (Style == format_style::text)
+            {
+                detail::put_address(output, Elements::address);
+                output.put(": ");
+            } else if constexpr (Style == format_style::json)
+            {
+                output.put('"');
+                detail::put_address(output, Elements::address);
+                output.put("\":");
+            }
+            using Bitfields = typename Elements::Register::bitfields;
+            detail::put_register<Style>(output,
+                                        registers.template get<Elements::address>(),
+                                        static_cast<Bitfields*>(nullptr));
+        }(),
+        ...);
+    if constexpr (Style == format_style::json)
+        output.put('}');
+    return output.result();
+}
+
+/**
+ * \brief Writes the CSV header with the names of the bitfields of the register, or of all the registers of the
+ *        jungles::register_file, prefixed with the addresses, e.g. "0x1.icc,0x1.en_ntc,...".
+ */
+template<typename Registers>
+std::to_chars_result format_header(char* first, char* last)
+{
+    detail::format_output output{first, last};
+    detail::put_header(output, static_cast<Registers*>(nullptr));
+    return output.result();
+}
+
+} // namespace jungles
+
+#endif /* FORMAT_HPP */
@@ -0,0 +1,351 @@
+/**
+ * @file	frame.hpp
+ * @brief	Layout of a protocol header composed of back-to-back registers, decoded and encoded in place.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FRAME_HPP
+#define FRAME_HPP
+
+#include "small_register/byte_order.hpp"
+#include "small_register/register_ref.hpp"
+#include "small_register/small_register_internal.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace jungles
+{
+
+namespace detail
+{
+
+template<auto Id, typename Bitfield>
+constexpr bool is_bitfield_with_id()
+{
+    if constexpr (std::is_same_v<decltype(Id), std::remove_cv_t<decltype(Bitfield::id)>>)
+        return Bitfield::id == Id;
+    else
+        return false;
+}
+
+template<auto Id, typename... Bitfields>
+constexpr bool has_bitfield(std::tuple<Bitfields...>*)
+{
+    return (is_bitfield_with_id<Id, Bitfields>() || ...);
+}
+
+} // namespace detail
+
+/**
+ * \brief Describes a frame, e.g. a protocol header, made of registers laid out one after another in a byte buffer.
+ *
+ * The frame owns no data: a view decodes and patches the registers directly within the caller's buffer, and encode()
+ * writes them to the caller's buffer, so no heap allocation nor intermediate copy of the frame is made. Each register
+ * occupies sizeof(underlying_type) bytes, in the Order.
+ *
+ *     using Ipv4 = frame<VersionAndLength, Identification, TtlAndProtocol, Checksum, Address, Address>;
+ *
+ *     for (auto header : Ipv4::frames(buffer, received))
+ *         if (header.get<ipv4::protocol>() == udp)
+ *             header.assign<ipv4::ttl>(header.get<ipv4::ttl>() - 1);
+ *
+ * The bitfields can be accessed by their IDs, as long as each ID is found in exactly one register of the frame.
+ *
+ * \tparam Order Order of the bytes of each register. Use jungles::frame alias for Big Endian, the network order.
+ * \tparam Registers jungles::small_register template instances, in the order they appear in the buffer.
+ */
+template<byte_order Order, typename... Registers>
+class basic_frame
+{
+  private:
+    static_assert(sizeof...(Registers) > 0, "Frame must consist of at least one register");
+
+    static inline constexpr std::array sizes{sizeof(typename Registers::underlying_type)...};
+
+    static constexpr std::array<std::size_t, sizeof...(Registers)> compute_offsets()
+    {
+        std::array<std::size_t, sizeof...(Registers)> result{};
+        for (std::size_t i{1}; i < sizes.size(); ++i)
+            result[i] = result[i - 1] + sizes[i - 1];
+        return result;
+    }
+
+    static inline constexpr auto offsets{compute_offsets()};
+
+    template<auto Id>
+    static constexpr std::size_t find_register()
+    {
+        constexpr std::array has_id{detail::has_bitfield<Id>(static_cast<typename Registers::bitfields*>(nullptr))...};
+        constexpr auto count{detail::accumulate(std::begin(has_id), std::end(has_id), std::size_t{0})};
+        static_assert(count != 0, "Bitfield ID not found");
+        static_assert(count < 2, "Bitfield ID is ambiguous within the frame");
+        return detail::find(std::begin(has_id), std::end(has_id), true) - std::begin(has_id);
+    }
+
+    template<auto Id>
+    static inline constexpr std::size_t register_index{find_register<Id>()};
+
+  public:
+    //! Size of the frame in bytes.
+    static inline constexpr std::size_t size{detail::accumulate(std::begin(sizes), std::end(sizes), std::size_t{0})};
+
+    //! Number of the registers the frame is composed of.
+    static inline constexpr std::size_t register_count{sizeof...(Registers)};
+
+    //! Type of the register at the Index.
+    template<std::size_t Index>
+    using register_type = detail::nth_type<Index, Registers...>;
+
+    //! Offset of the register at the Index, in bytes from the beginning of the frame.
+    template<std::size_t Index>
+    static inline constexpr std::size_t offset{offsets[Index]};
+
+    /**
+     * \brief Non-owning view of a frame within a buffer. Frames within const buffers can be only read.
+     * \tparam Byte uint8_t, unsigned char, char or std::byte, possibly const.
+     */
+    template<typename Byte>
+    class view
+    {
+      private:
+        static_assert(detail::is_byte<Byte>, "Frames can be viewed only within buffers of bytes");
+
+        static inline constexpr bool is_mutable{!std::is_const_v<Byte>};
+
+        template<typename Result>
+        decltype(auto) chain(Result&& result)
+        {
+            if constexpr (std::is_lvalue_reference_v<Result>)
+                return *this;
+            else
+                return std::forward<Result>(result);
+        }
+
+      public:
+        //! Views size bytes starting from data, which shall remain valid for the lifetime of the view.
+        explicit view(Byte* data) : bytes{data}
+        {
+        }
+
+        //! Returns the beginning of the frame.
+        Byte* data() const
+        {
+            return bytes;
+        }
+
+        //! Decodes the register at the Index.
+        template<std::size_t Index>
+        register_type<Index> load() const
+        {
+            using Register = register_type<Index>;
+            return Register{detail::load<Order, typename Register::underlying_type>(
+                reinterpret_cast<const uint8_t*>(bytes) + offset<Index>)};
+        }
+
+        //! Overwrites the register at the Index.
+        template<std::size_t Index>
+        view& store(const register_type<Index>& reg)
+        {
+            static_assert(is_mutable, "Frames within const buffers can't be modified");
+            detail::store<Order>(reg(), reinterpret_cast<uint8_t*>(bytes) + offset<Index>);
+            return *this;
+        }
+
+        //! Returns view of the register at the Index, which applies the operations directly to the buffer.
+        template<std::size_t Index>
+        register_ref<register_type<Index>, Order> ref() const
+        {
+            static_assert(is_mutable, "Frames within const buffers can't be modified");
+            return register_ref<register_type<Index>, Order>{bytes + offset<Index>};
+        }
+
+        //! Returns the value of the bitfield, decoding only the register which holds it.
+        template<auto Id>
+        auto get() const
+        {
+            return load<register_index<Id>>().template get<Id>();
+        }
+
+        //! See basic_small_register::set().
+        template<auto Id>
+        view& set()
+        {
+            ref<register_index<Id>>().template set<Id>();
+            return *this;
+        }
+
+        //! See basic_small_register::set(values).
+        template<auto Id>
+        decltype(auto) set(typename register_type<register_index<Id>>::underlying_type value)
+        {
+            return chain(ref<register_index<Id>>().template set<Id>(value));
+        }
+
+        //! See basic_small_register::assign(values).
+        template<auto Id>
+        decltype(auto) assign(typename register_type<register_index<Id>>::underlying_type value)
+        {
+            return chain(ref<register_index<Id>>().template assign<Id>(value));
+        }
+
+        //! See basic_small_register::clear().
+        template<auto Id>
+        view& clear()
+        {
+            ref<register_index<Id>>().template clear<Id>();
+            return *this;
+        }
+
+        //! See basic_small_register::clear(masks).
+        template<auto Id>
+        decltype(auto) clear(typename register_type<register_index<Id>>::underlying_type mask)
+        {
+            return chain(ref<register_index<Id>>().template clear<Id>(mask));
+        }
+
+      private:
+        Byte* bytes;
+    };
+
+    /**
+     * \brief Back-to-back frames within a buffer, e.g. a batch of received packets, iterated without copying.
+     *
+     * The trailing bytes which don't make up a whole frame are skipped by the iteration. Their count is returned by
+     * remainder(), so that they can be kept until the rest of the frame is received.
+     */
+    template<typename Byte>
+    class sequence
+    {
+      public:
+        class iterator
+        {
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = view<Byte>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = view<Byte>;
+
+            explicit iterator(Byte* start) : position{start}
+            {
+            }
+
+            view<Byte> operator*() const
+            {
+                return view<Byte>{position};
+            }
+
+            iterator& operator++()
+            {
+                position += size;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto previous{*this};
+                ++(*this);
+                return previous;
+            }
+
+            bool operator==(const iterator& other) const
+            {
+                return position == other.position;
+            }
+
+            bool operator!=(const iterator& other) const
+            {
+                return position != other.position;
+            }
+
+          private:
+            Byte* position;
+        };
+
+        sequence(Byte* data, std::size_t length) : first{data}, count{length / size}, trailing{length % size}
+        {
+        }
+
+        iterator begin() const
+        {
+            return iterator{first};
+        }
+
+        iterator end() const
+        {
+            return iterator{first + count * size};
+        }
+
+        //! Returns the number of the whole frames.
+        std::size_t frame_count() const
+        {
+            return count;
+        }
+
+        //! Returns the number of the trailing bytes which don't make up a whole frame.
+        std::size_t remainder() const
+        {
+            return trailing;
+        }
+
+      private:
+        Byte* first;
+        std::size_t count;
+        std::size_t trailing;
+    };
+
+    //! Returns view of the frame beginning at data.
+    template<typename Byte>
+    static view<Byte> make_view(Byte* data)
+    {
+        return view<Byte>{data};
+    }
+
+    //! Returns the back-to-back frames within length bytes starting from data.
+    template<typename Byte>
+    static sequence<Byte> frames(Byte* data, std::size_t length)
+    {
+        static_assert(detail::is_byte<Byte>, "Frames can be viewed only within buffers of bytes");
+        return sequence<Byte>{data, length};
+    }
+
+    //! Decodes all the registers of the frame.
+    template<typename Byte>
+    static std::tuple<Registers...> decode(const Byte* data)
+    {
+        return decode(make_view(data), std::index_sequence_for<Registers...>{});
+    }
+
+    //! Encodes the registers to size bytes starting from data.
+    template<typename Byte>
+    static void encode(Byte* data, const Registers&... registers)
+    {
+        encode(make_view(data), std::forward_as_tuple(registers...), std::index_sequence_for<Registers...>{});
+    }
+
+  private:
+    template<typename Byte, std::size_t... Indices>
+    static std::tuple<Registers...> decode(view<const Byte> frame, std::index_sequence<Indices...>)
+    {
+        return {frame.template load<Indices>()...};
+    }
+
+    template<typename Byte, typename Tuple, std::size_t... Indices>
+    static void encode(view<Byte> frame, const Tuple& registers, std::index_sequence<Indices...>)
+    {
+        (frame.template store<Indices>(std::get<Indices>(registers)), ...);
+    }
+};
+
+//! Frame with registers in Big Endian, the network byte order. See jungles::basic_frame.
+template<typename... Registers>
+using frame = basic_frame<byte_order::big, Registers...>;
+
+} // namespace jungles
+
+#endif /* FRAME_HPP */
@@ -0,0 +1,247 @@
+/**
+ * @file	key_lookup.hpp
+ * @brief	Tables generated at compile time which map runtime keys, e.g. register addresses, to their positions.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef KEY_LOOKUP_HPP
+#define KEY_LOOKUP_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace jungles
+{
+
+namespace detail
+{
+
+//! Converts the key, e.g. the register address, to the integer used by the runtime lookup tables.
+template<typename Key>
+constexpr std::uint64_t dispatch_key(Key key)
+{
+    static_assert(std::is_integral_v<Key> || std::is_enum_v<Key>,
+                  "Keys must be of integral or enumeration type to be dispatched at runtime");
+
+    if constexpr (std::is_enum_v<Key>)
+        return static_cast<std::uint64_t>(static_cast<std::underlying_type_t<Key>>(key));
+    else
+        return static_cast<std::uint64_t>(key);
+}
+
+constexpr std::uint64_t dispatch_hash(std::uint64_t key, std::uint64_t seed)
+{
+    key = (key ^ seed) * 0x9E3779B97F4A7C15u;
+    return key ^ (key >> 32);
+}
+
+constexpr std::size_t ceil_to_power_of_two(std::size_t value)
+{
+    std::size_t result{1};
+    while (result < value)
+        result *= 2;
+    return result;
+}
+
+//! Smallest unsigned type which can store the positions of the keys and the "not found" marker.
+template<std::size_t Count>
+using position_type = std::conditional_t<Count < UINT8_MAX,
+                                         std::uint8_t,
+                                         std::conditional_t<Count < UINT16_MAX, std::uint16_t, std::uint32_t>>;
+
+/**
+ * \brief Maps the key to its position through a table indexed with the offset from the lowest key.
+ *
+ * Used when the keys are dense, so the table is small. Holes hold Count, which marks missing keys.
+ */
+template<std::size_t Count, std::size_t Span>
+struct dense_lookup
+{
+    static inline constexpr bool is_built{true};
+
+    std::uint64_t lowest;
+    std::array<position_type<Count>, Span> positions;
+
+    static constexpr dense_lookup make(const std::array<std::uint64_t, Count>& keys, std::uint64_t lowest)
+    {
+        dense_lookup result{lowest, {}};
+        for (auto& position : result.positions)
+            position = Count;
+        for (std::size_t i{0}; i < Count; ++i)
+            result.positions[keys[i] - lowest] = static_cast<position_type<Count>>(i);
+        return result;
+    }
+
+    constexpr std::size_t find(std::uint64_t key) const
+    {
+        auto offset{key - lowest};
+        return offset < Span ? positions[offset] : Count;
+    }
+};
+
+/**
+ * \brief Maps the key to its position through a perfect hash table.
+ *
+ * Hash and displace: the keys are distributed among Buckets with the first hash. For each bucket, starting from the
+ * largest, a seed of the second hash is searched, which places all the keys of the bucket in free slots. A lookup costs
+ * thus two hash computations and a single key comparison, regardless whether the key is found.
+ */
+template<std::size_t Count, std::size_t Buckets, std::size_t Slots>
+struct hashed_lookup
+{
+    bool is_built;
+    std::array<std::uint64_t, Buckets> seeds;
+    std::array<std::uint64_t, Slots> keys;
+    std::array<position_type<Count>, Slots> positions;
+
+    //! Maximum number of seeds tried for a bucket.
+    static inline constexpr std::uint64_t seed_search_limit{1u << 16};
+
+    static constexpr std::size_t bucket_of(std::uint64_t key)
+    {
+        return dispatch_hash(key, 0) & (Buckets - 1);
+    }
+
+    static constexpr std::size_t slot_of(std::uint64_t key, std::uint64_t seed)
+    {
+        return dispatch_hash(key, seed) & (Slots - 1);
+    }
+
+    static constexpr hashed_lookup make(const std::array<std::uint64_t, Count>& input_keys)
+    {
+        hashed_lookup result{true, {}, {}, {}};
+        for (auto& position : result.positions)
+            position = Count;
+
+        // Groups the positions of the keys by buckets: the bucket b holds order[begins[b]] ... order[begins[b + 1] - 1].
+        std::array<std::size_t, Buckets + 1> begins{};
+        for (auto key : input_keys)
+            ++begins[bucket_of(key) + 1];
+        std::size_t largest_bucket{0};
+        for (std::size_t bucket{0}; bucket < Buckets; ++bucket)
+        {
+            auto size{begins[bucket + 1]};
+            largest_bucket = size > largest_bucket ? size : largest_bucket;
+            begins[bucket + 1] += begins[bucket];
+        }
+        std::array<std::size_t, Count> order{};
+        std::array<std::size_t, Buckets> filled{};
+        for (std::size_t i{0}; i < Count; ++i)
+        {
+            auto bucket{bucket_of(input_keys[i])};
+            order[begins[bucket] + filled[bucket]++] = i;
+        }
+
+        for (auto size{largest_bucket}; size > 0; --size)
+        {
+            for (std::size_t bucket{0}; bucket < Buckets; ++bucket)
+            {
+                auto first{begins[bucket]}, last{begins[bucket + 1]};
+                if (last - first == size && !result.place_bucket(input_keys, order, first, last, bucket))
+                    result.is_built = false;
+            }
+        }
+        return result;
+    }
+
+    //! Finds the seed which places the keys order[first] ... order[last - 1] in distinct free slots.
+    constexpr bool place_bucket(const std::array<std::uint64_t, Count>& input_keys,
+                                const std::array<std::size_t, Count>& order,
+                                std::size_t first,
+                                std::size_t last,
+                                std::size_t bucket)
+    {
+        for (std::uint64_t seed{1}; seed < seed_search_limit; ++seed)
+        {
+            std::size_t placed{first};
+            for (; placed < last; ++placed)
+            {
+                auto slot{slot_of(input_keys[order[placed]], seed)};
+                if (positions[slot] != Count)
+                    break;
+                positions[slot] = static_cast<position_type<Count>>(order[placed]);
+                keys[slot] = input_keys[order[placed]];
+            }
+            if (placed == last)
+            {
+                seeds[bucket] = seed;
+                return true;
+            }
+            // Reverts the partial placement.
+            for (auto i{first}; i < placed; ++i)
+                positions[slot_of(input_keys[order[i]], seed)] = Count;
+        }
+        return false;
+    }
+
+    constexpr std::size_t find(std::uint64_t key) const
+    {
+        auto slot{slot_of(key, seeds[bucket_of(key)])};
+        return keys[slot] == key ? positions[slot] : Count;
+    }
+};
+
+/**
+ * \brief Finds the position of the key among the Keys without a chain of comparisons: through a table indexed with the
+ *        key, when the keys are dense, or a perfect hash table otherwise.
+ *
+ * find() returns the number of the Keys when the key is not found.
+ */
+template<auto... Keys>
+struct key_lookup
+{
+    static inline constexpr std::size_t size{sizeof...(Keys)};
+    static inline constexpr std::array<std::uint64_t, size> keys{dispatch_key(Keys)...};
+
+    static constexpr std::uint64_t lowest()
+    {
+        std::uint64_t result{keys[0]};
+        for (auto key : keys)
+            result = key < result ? key : result;
+        return result;
+    }
+
+    static constexpr std::uint64_t highest()
+    {
+        std::uint64_t result{keys[0]};
+        for (auto key : keys)
+            result = key > result ? key : result;
+        return result;
+    }
+
+    static inline constexpr std::uint64_t span{highest() - lowest() + 1};
+
+    //! Dense tables waste at most a few bytes per key for the holes between the keys.
+    static inline constexpr bool is_dense{span != 0 && span <= 4 * size + 16};
+
+    static constexpr auto make_table()
+    {
+        if constexpr (is_dense)
+        {
+            return dense_lookup<size, static_cast<std::size_t>(span)>::make(keys, lowest());
+        } else
+        {
+            // The load factor 0.5 makes the seed search short.
+            constexpr auto slots{ceil_to_power_of_two(2 * size)};
+            constexpr auto buckets{ceil_to_power_of_two(size / 2 + 1)};
+            return hashed_lookup<size, buckets, slots>::make(keys);
+        }
+    }
+
+    static inline constexpr auto table{make_table()};
+
+    static_assert(table.is_built, "Couldn't generate the perfect hash table of the keys");
+
+    template<typename Key>
+    static constexpr std::size_t find(Key key)
+    {
+        return table.find(dispatch_key(key));
+    }
+};
+
+} // namespace detail
+
+} // namespace jungles
+
+#endif /* KEY_LOOKUP_HPP */
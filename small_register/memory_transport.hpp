@@ -0,0 +1,78 @@
+/**
+ * @file	memory_transport.hpp
+ * @brief	In-memory transport which emulates a device and counts the transactions, for tests and benchmarks.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef MEMORY_TRANSPORT_HPP
+#define MEMORY_TRANSPORT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace jungles
+{
+
+/**
+ * \brief Emulates a device with Size bytes of register space, which auto-increments the address after each byte.
+ *
+ * Satisfies the transport requirements of jungles::small_map::read() and jungles::small_map::write(). Each call of
+ * read() or write() counts as a single transaction.
+ */
+template<std::size_t Size>
+struct memory_transport
+{
+    //! Reads size bytes starting from the address first.
+    template<typename Address>
+    void read(Address first, uint8_t* data, std::size_t size)
+    {
+        auto begin{check_range(first, size)};
+        std::memcpy(data, memory.data() + begin, size);
+        ++reads;
+        bytes_read += size;
+    }
+
+    //! Writes size bytes starting from the address first.
+    template<typename Address>
+    void write(Address first, const uint8_t* data, std::size_t size)
+    {
+        auto begin{check_range(first, size)};
+        std::memcpy(memory.data() + begin, data, size);
+        ++writes;
+        bytes_written += size;
+    }
+
+    //! Total number of transactions performed.
+    std::size_t transactions() const
+    {
+        return reads + writes;
+    }
+
+    //! Zeroes the counters, leaving the memory unchanged.
+    void reset_counters()
+    {
+        reads = writes = bytes_read = bytes_written = 0;
+    }
+
+    std::array<uint8_t, Size> memory{};
+    std::size_t reads{0};
+    std::size_t writes{0};
+    std::size_t bytes_read{0};
+    std::size_t bytes_written{0};
+
+  private:
+    template<typename Address>
+    static std::size_t check_range(Address first, std::size_t size)
+    {
+        auto begin{static_cast<std::size_t>(first)};
+        if (begin > Size || size > Size - begin)
+            throw std::out_of_range{"Transaction exceeds the memory of the transport"};
+        return begin;
+    }
+};
+
+} // namespace jungles
+
+#endif /* MEMORY_TRANSPORT_HPP */
@@ -0,0 +1,352 @@
+/**
+ * @file	mmio_register.hpp
+ * @brief	Binds the bitfield layout of a small_register to a memory-mapped register accessed through a volatile pointer.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef MMIO_REGISTER_HPP
+#define MMIO_REGISTER_HPP
+
+#include "small_register/small_register.hpp"
+#include "small_register/small_register_internal.hpp"
+
+#include <cassert>
+#include <system_error>
+#include <type_traits>
+
+namespace jungles
+{
+
+namespace detail
+{
+
+//! The Bitfield without jungles::read_only, jungles::write_only or jungles::write_1_to_clear.
+template<typename Bitfield>
+struct without_access
+{
+    using type = Bitfield;
+};
+
+template<typename Bitfield>
+struct without_access<read_only<Bitfield>>
+{
+    using type = Bitfield;
+};
+
+template<typename Bitfield>
+struct without_access<write_only<Bitfield>>
+{
+    using type = Bitfield;
+};
+
+template<typename Bitfield>
+struct without_access<write_1_to_clear<Bitfield>>
+{
+    using type = Bitfield;
+};
+
+//! The overflow policy without the tracer of jungles::instrumented.
+template<typename Policy>
+struct without_tracer
+{
+    using type = Policy;
+};
+
+template<typename Policy, typename Tracer>
+struct without_tracer<instrumented<Policy, Tracer>>
+{
+    using type = Policy;
+};
+
+//! The register with the same layout and overflow policy, with no access restrictions on the bitfields and no tracer.
+template<typename OverflowPolicy, typename RegisterUnderlyingType, typename... Bitfields>
+struct without_access<basic_small_register<OverflowPolicy, RegisterUnderlyingType, Bitfields...>>
+{
+    using type = basic_small_register<typename without_tracer<OverflowPolicy>::type,
+                                      RegisterUnderlyingType,
+                                      typename without_access<Bitfields>::type...>;
+};
+
+} // namespace detail
+
+/**
+ * \brief Default access policy of jungles::mmio_register which performs plain volatile loads and stores.
+ *
+ * A custom policy, e.g. one counting the accesses for tests, shall provide the same two static methods.
+ */
+template<typename T>
+struct volatile_access
+{
+    static T load(const volatile T* address)
+    {
+        return *address;
+    }
+
+    static void store(volatile T* address, T value)
+    {
+        *address = value;
+    }
+};
+
+/**
+ * \brief Memory-mapped register with the layout of SmallRegister, e.g. a peripheral register of a microcontroller or
+ *        a hardware window mapped with mmap().
+ *
+ * Each operation performs exactly one load and one store of the whole register:
+ * - get() and read() perform a single load,
+ * - write() performs a single store,
+ * - set(), assign() and clear() perform a single read-modify-write, also when multiple bitfields are specified,
+ * - modify() applies any number of operations to the register with a single read-modify-write.
+ *
+ * Chained operations, like "r.set<a>().clear<b>()", perform a read-modify-write each. Use modify() or jungles::defer()
+ * to merge them.
+ *
+ * When the overflow policy is jungles::overflow::return_error and an error is returned, nothing is stored.
+ *
+ * The access metadata of the bitfields is respected: the write-only bitfields can't be read with get(), the registers
+ * without read-write bitfields are modified without any load, and only the write-1-to-clear bits cleared by the
+ * operation are written as ones, see basic_small_register::written_value().
+ *
+ * Registers with separate set and clear aliases (writing ones to the alias sets or clears the corresponding bits of
+ * the register atomically) are written with set_only() and clear_only(), without any load. The aliases shall be
+ * passed to the constructor before these are called. clear_only() accepts any bitfield, e.g. a read-only status
+ * cleared through its alias, while set_only() accepts only the bitfields which set() accepts.
+ *
+ *     mmio_register<GpioOut> gpio{reinterpret_cast<volatile uint32_t*>(0x50000504)};
+ *     gpio.assign<gpio_out::pin3, gpio_out::pin4>(1, 0);
+ *
+ * \tparam SmallRegister jungles::small_register template instance which defines the layout.
+ * \tparam Access Policy which performs the loads and the stores, jungles::volatile_access by default.
+ */
+template<typename SmallRegister, typename Access = volatile_access<typename SmallRegister::underlying_type>>
+class mmio_register
+{
+  private:
+    using Register = typename SmallRegister::underlying_type;
+
+    static inline constexpr Register flags{SmallRegister::template access_mask<field_access::write_1_to_clear>};
+
+    static inline constexpr Register write_only_bits{SmallRegister::template access_mask<field_access::write_only>};
+
+    using OverflowPolicy = typename SmallRegister::overflow_policy;
+
+    /**
+     * \brief Builds the bits written to the clear alias, which the access of the bitfields doesn't restrict.
+     *
+     * It has no tracer: the operation is reported by trace() as a clear of the SmallRegister.
+     */
+    using ClearAliasBits = typename detail::without_access<SmallRegister>::type;
+
+    //! Reports the operation on the bitfields to the tracer of jungles::instrumented policy. No code without a tracer.
+    template<auto... Ids>
+    static void trace(access operation)
+    {
+        if constexpr (detail::is_traced<OverflowPolicy>)
+            (OverflowPolicy::tracer::template record<SmallRegister, Ids>(operation), ...);
+    }
+
+    /**
+     * \brief The register as assumed for a read-modify-write, loaded only when it has read-write bits to preserve.
+     *
+     * The write-only bits are zeroed, as their read-back is meaningless, e.g. a trigger would fire again.
+     */
+    SmallRegister load_for_update() const
+    {
+        if constexpr (SmallRegister::template access_mask<field_access::read_write> == 0)
+            return SmallRegister{flags};
+        else
+            return SmallRegister{static_cast<Register>(Access::load(address) & ~write_only_bits)};
+    }
+
+  public:
+    //! Type of the register which defines the layout.
+    using register_type = SmallRegister;
+
+    //! Type of the register value.
+    using underlying_type = Register;
+
+    /**
+     * \param address Address of the register.
+     * \param set_alias Address to which the bits to set are written by set_only(), if the register has one.
+     * \param clear_alias Address to which the bits to clear are written by clear_only(), if the register has one.
+     */
+    explicit mmio_register(volatile Register* address,
+                           volatile Register* set_alias = nullptr,
+                           volatile Register* clear_alias = nullptr) :
+        address{address}, set_alias{set_alias}, clear_alias{clear_alias}
+    {
+    }
+
+    //! Loads the register.
+    SmallRegister read() const
+    {
+        return SmallRegister{Access::load(address)};
+    }
+
+    //! Stores the register, without loading it first.
+    void write(const SmallRegister& reg)
+    {
+        Access::store(address, reg());
+    }
+
+    //! Returns the value of the specified bitfield, or a tuple of the values if multiple IDs are specified.
+    template<auto... Ids>
+    auto get() const
+    {
+        static_assert(((SmallRegister::template bitfield_type<Ids>::access != field_access::write_only) && ...),
+                      "Bitfield is write-only");
+        return read().template get<Ids...>();
+    }
+
+    //! See basic_small_register::set().
+    template<auto Id, auto... Ids>
+    mmio_register& set()
+    {
+        return modify([](auto& reg) -> decltype(auto) { return reg.template set<Id, Ids...>(); });
+    }
+
+    //! See basic_small_register::set(values).
+    template<auto... Ids>
+    decltype(auto) set(typename detail::type_for<Register, Ids>::type... values)
+    {
+        return modify([&](auto& reg) -> decltype(auto) { return reg.template set<Ids...>(values...); });
+    }
+
+    //! See basic_small_register::assign().
+    template<auto Id, auto Value>
+    mmio_register& assign()
+    {
+        return modify([](auto& reg) -> decltype(auto) { return reg.template assign<Id, Value>(); });
+    }
+
+    //! See basic_small_register::assign(values).
+    template<auto... Ids>
+    decltype(auto) assign(typename detail::type_for<Register, Ids>::type... values)
+    {
+        return modify([&](auto& reg) -> decltype(auto) { return reg.template assign<Ids...>(values...); });
+    }
+
+    //! See basic_small_register::clear().
+    template<auto Id, auto... Ids>
+    mmio_register& clear()
+    {
+        return modify([](auto& reg) -> decltype(auto) { return reg.template clear<Id, Ids...>(); });
+    }
+
+    //! See basic_small_register::clear(masks).
+    template<auto... Ids>
+    decltype(auto) clear(typename detail::type_for<Register, Ids>::type... masks)
+    {
+        return modify([&](auto& reg) -> decltype(auto) { return reg.template clear<Ids...>(masks...); });
+    }
+
+    /**
+     * \brief Loads the register, calls the function with the register and stores the result.
+     *
+     * E.g. "r.modify([](auto& reg) { reg.template set<a>().template clear<b>(); });".
+     *
+     * A register without read-write bitfields isn't loaded: the function gets zeros, with the write-1-to-clear bits
+     * set, so that the bitfields cleared by the function are written as ones. The write-only bitfields are zeroed
+     * after the load.
+     *
+     * \returns Reference to self, or the error code if the function returns one and the policy is
+     *          jungles::overflow::return_error. The register is not stored on error.
+     */
+    template<typename Function>
+    decltype(auto) modify(Function function)
+    {
+        const auto before{load_for_update()};
+        auto reg{before};
+        if constexpr (std::is_same_v<decltype(function(reg)), std::errc>)
+        {
+            auto result{function(reg)};
+            if (result == std::errc{})
+                Access::store(address, SmallRegister::written_value(before(), reg()));
+            return result;
+        } else
+        {
+            function(reg);
+            Access::store(address, SmallRegister::written_value(before(), reg()));
+            return *this;
+        }
+    }
+
+    //! Writes ones to the bits of the specified bitfields, or the compile-time value, to the set alias.
+    template<auto Id, auto... Ids>
+    void set_only()
+    {
+        assert(set_alias != nullptr && "Register has no set alias");
+        SmallRegister bits{0};
+        bits.template set<Id, Ids...>();
+        Access::store(set_alias, bits());
+    }
+
+    /**
+     * \brief Writes the values shifted to the positions of the bitfields to the set alias, without loading the register.
+     * \returns Nothing, or the error code under jungles::overflow::return_error, in which case nothing is stored.
+     */
+    template<auto... Ids>
+    decltype(auto) set_only(typename detail::type_for<Register, Ids>::type... values)
+    {
+        assert(set_alias != nullptr && "Register has no set alias");
+        return write_alias<SmallRegister>(
+            set_alias, [&](auto& bits) -> decltype(auto) { return bits.template set<Ids...>(values...); });
+    }
+
+    //! Writes ones to the bits of the specified bitfields, or the compile-time mask, to the clear alias.
+    template<auto Id, auto... Ids>
+    void clear_only()
+    {
+        assert(clear_alias != nullptr && "Register has no clear alias");
+        ClearAliasBits bits{0};
+        bits.template set<Id, Ids...>();
+        // Under "clear_only<Id, Mask>()" only the first parameter is a bitfield ID.
+        if constexpr ((std::is_same_v<decltype(Id), decltype(Ids)> && ...))
+            trace<Id, Ids...>(access::clear);
+        else
+            trace<Id>(access::clear);
+        Access::store(clear_alias, bits());
+    }
+
+    /**
+     * \brief Writes the masks shifted to the positions of the bitfields to the clear alias, without loading the
+     *        register.
+     * \returns Nothing, or the error code under jungles::overflow::return_error, in which case nothing is stored.
+     */
+    template<auto... Ids>
+    decltype(auto) clear_only(typename detail::type_for<Register, Ids>::type... masks)
+    {
+        assert(clear_alias != nullptr && "Register has no clear alias");
+        trace<Ids...>(access::clear);
+        if constexpr (detail::is_traced<OverflowPolicy>)
+            ((detail::is_in_range(masks, SmallRegister::template mask<Ids>()) ? void() : trace<Ids>(access::overflow)),
+             ...);
+        return write_alias<ClearAliasBits>(
+            clear_alias, [&](auto& bits) -> decltype(auto) { return bits.template set<Ids...>(masks...); });
+    }
+
+  private:
+    template<typename Bits, typename Function>
+    decltype(auto) write_alias(volatile Register* alias, Function function)
+    {
+        Bits bits{0};
+        if constexpr (std::is_same_v<decltype(function(bits)), std::errc>)
+        {
+            auto result{function(bits)};
+            if (result == std::errc{})
+                Access::store(alias, bits());
+            return result;
+        } else
+        {
+            function(bits);
+            Access::store(alias, bits());
+        }
+    }
+
+    volatile Register* address;
+    volatile Register* set_alias;
+    volatile Register* clear_alias;
+};
+
+} // namespace jungles
+
+#endif /* MMIO_REGISTER_HPP */
@@ -0,0 +1,285 @@
+/**
+ * @file	register_diff.hpp
+ * @brief	Detection of the bitfields which changed between two snapshots of a register, and dispatch of the changes to
+ *          per-bitfield handlers.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef REGISTER_DIFF_HPP
+#define REGISTER_DIFF_HPP
+
+#include "small_register/small_register_internal.hpp"
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace jungles
+{
+
+namespace detail
+{
+
+//! Returns the index of the least significant set bit. The value shall not be zero.
+template<typename T>
+inline unsigned count_trailing_zeros(T value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (sizeof(T) <= sizeof(unsigned))
+        return static_cast<unsigned>(__builtin_ctz(value));
+    else
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+    unsigned result{0};
+    for (; (value & 1) == 0; value >>= 1)
+        ++result;
+    return result;
+#endif
+}
+
+/**
+ * \brief Maps the bits of the SmallRegister to the positions of the bitfields within the Ids.
+ *
+ * Bits of the bitfields not within Ids are mapped to the count of the Ids, and are excluded from the mask.
+ */
+template<typename SmallRegister, auto... Ids>
+struct bitfield_bits
+{
+    using Register = typename SmallRegister::underlying_type;
+
+    static inline constexpr std::size_t bit_size{sizeof(Register) * CHAR_BIT};
+
+    static inline constexpr std::array<Register, sizeof...(Ids)> masks{
+        static_cast<Register>(SmallRegister::template mask<Ids>() << SmallRegister::template shift<Ids>())...};
+
+    static constexpr Register compute_mask()
+    {
+        Register result{0};
+        for (auto m : masks)
+            result |= m;
+        return result;
+    }
+
+    static constexpr std::array<uint8_t, bit_size> compute_positions()
+    {
+        std::array<uint8_t, bit_size> result{};
+        for (std::size_t bit{0}; bit < bit_size; ++bit)
+        {
+            result[bit] = static_cast<uint8_t>(sizeof...(Ids));
+            for (std::size_t i{0}; i < masks.size(); ++i)
+                if ((masks[i] >> bit) & 1)
+                    result[bit] = static_cast<uint8_t>(i);
+        }
+        return result;
+    }
+
+    static inline constexpr Register all{compute_mask()};
+    static inline constexpr auto positions{compute_positions()};
+};
+
+template<typename SmallRegister, typename Indices>
+struct all_bitfield_bits;
+
+template<typename SmallRegister, std::size_t... Indices>
+struct all_bitfield_bits<SmallRegister, std::index_sequence<Indices...>>
+{
+    using type =
+        bitfield_bits<SmallRegister, std::tuple_element_t<Indices, typename SmallRegister::bitfields>::id...>;
+};
+
+/**
+ * Calls the function, with the position of each of the bitfields having a changed bit, iterating over the set bits of
+ * the changes. The bits of each visited bitfield are skipped at once.
+ */
+template<typename Bits, typename Function>
+inline void for_each_changed_bitfield(typename Bits::Register changes, Function function)
+{
+    for (auto remaining{static_cast<typename Bits::Register>(changes & Bits::all)}; remaining != 0;)
+    {
+        auto position{Bits::positions[count_trailing_zeros(remaining)]};
+        function(position);
+        remaining = static_cast<typename Bits::Register>(remaining & ~Bits::masks[position]);
+    }
+}
+
+} // namespace detail
+
+/**
+ * \brief Bitfields of the SmallRegister which differ between two snapshots, found with a single XOR.
+ *
+ *     auto changes{diff(previous_status, status)};
+ *     if (changes.changed<status::chg>())
+ *         ...
+ *
+ * \tparam SmallRegister jungles::small_register template instance.
+ */
+template<typename SmallRegister>
+class register_diff
+{
+  private:
+    using Register = typename SmallRegister::underlying_type;
+    using Bits =
+        typename detail::all_bitfield_bits<SmallRegister,
+                                           std::make_index_sequence<SmallRegister::bitfield_count>>::type;
+
+    template<std::size_t Index>
+    using bitfield_at = std::tuple_element_t<Index, typename SmallRegister::bitfields>;
+
+    template<typename Visitor, std::size_t Index>
+    static void visit(Visitor& visitor)
+    {
+        visitor(std::integral_constant<decltype(bitfield_at<Index>::id), bitfield_at<Index>::id>{});
+    }
+
+    template<typename Visitor, std::size_t... Indices>
+    static constexpr std::array<void (*)(Visitor&), sizeof...(Indices)> make_visitor_table(
+        std::index_sequence<Indices...>)
+    {
+        return {&visit<Visitor, Indices>...};
+    }
+
+    template<typename Visitor>
+    static inline constexpr auto visitor_table{
+        make_visitor_table<Visitor>(std::make_index_sequence<SmallRegister::bitfield_count>{})};
+
+  public:
+    constexpr register_diff(const SmallRegister& old_value, const SmallRegister& new_value) :
+        changes{static_cast<Register>(old_value() ^ new_value())}
+    {
+    }
+
+    //! Returns true if any bit of the bitfield differs.
+    template<auto Id>
+    constexpr bool changed() const
+    {
+        constexpr auto mask{SmallRegister::template mask<Id>()};
+        return (changes & static_cast<Register>(mask << SmallRegister::template shift<Id>())) != 0;
+    }
+
+    //! Returns true if any bitfield differs.
+    constexpr bool any() const
+    {
+        return changes != 0;
+    }
+
+    constexpr explicit operator bool() const
+    {
+        return any();
+    }
+
+    //! Returns the bits which differ.
+    constexpr Register bits() const
+    {
+        return changes;
+    }
+
+    /**
+     * Calls the visitor with std::integral_constant holding the ID of each bitfield which differs, iterating over the
+     * set bits of the difference, from the last bitfield to the first one.
+     */
+    template<typename Visitor>
+    void for_each_changed(Visitor visitor) const
+    {
+        detail::for_each_changed_bitfield<Bits>(changes,
+                                                [&](auto position) { visitor_table<Visitor>[position](visitor); });
+    }
+
+  private:
+    Register changes;
+};
+
+//! Finds the bitfields which differ between the snapshots of the register. See jungles::register_diff.
+template<typename SmallRegister>
+constexpr register_diff<SmallRegister> diff(const SmallRegister& old_value, const SmallRegister& new_value)
+{
+    return register_diff<SmallRegister>{old_value, new_value};
+}
+
+//! Handler of the changes of the bitfield Id, created with jungles::on().
+template<auto Id, typename Function>
+struct change_handler
+{
+    static inline constexpr auto id{Id};
+
+    Function function;
+};
+
+//! Creates the handler called with (old value, new value) of the bitfield Id, when it changes.
+template<auto Id, typename Function>
+constexpr change_handler<Id, Function> on(Function function)
+{
+    return change_handler<Id, Function>{function};
+}
+
+/**
+ * \brief Calls the handlers of the bitfields which differ between two snapshots of the SmallRegister.
+ *
+ * Only the set bits of the difference, masked with the bitfields having handlers, are iterated, so the cost depends on
+ * the number of the changed bitfields rather than on the number of the handlers:
+ *
+ *     auto on_status_change{make_dispatcher<Status>(
+ *         on<status::chg>([](auto old_value, auto new_value) { ... }),
+ *         on<status::ntc>([](auto old_value, auto new_value) { ... }))};
+ *
+ *     on_status_change(previous_status, status);
+ *
+ * \tparam SmallRegister jungles::small_register template instance.
+ * \tparam Handlers jungles::change_handler template instances, created with jungles::on().
+ */
+template<typename SmallRegister, typename... Handlers>
+class change_dispatcher
+{
+  private:
+    using Register = typename SmallRegister::underlying_type;
+    using Bits = detail::bitfield_bits<SmallRegister, Handlers::id...>;
+    using Call = void (*)(std::tuple<Handlers...>&, const SmallRegister&, const SmallRegister&);
+
+    static_assert(detail::has_unique_values<Handlers::id...>(), "Bitfield IDs must be unique");
+
+    template<std::size_t Index>
+    static void call(std::tuple<Handlers...>& handlers, const SmallRegister& old_value, const SmallRegister& new_value)
+    {
+        auto& handler{std::get<Index>(handlers)};
+        constexpr auto id{std::remove_reference_t<decltype(handler)>::id};
+        handler.function(old_value.template get<id>(), new_value.template get<id>());
+    }
+
+    template<std::size_t... Indices>
+    static constexpr std::array<Call, sizeof...(Indices)> make_calls(std::index_sequence<Indices...>)
+    {
+        return {&call<Indices>...};
+    }
+
+    static inline constexpr auto calls{make_calls(std::index_sequence_for<Handlers...>{})};
+
+  public:
+    constexpr explicit change_dispatcher(Handlers... handlers) : handlers{handlers...}
+    {
+    }
+
+    //! Calls the handlers of the bitfields which differ. Returns true if any of the handlers was called.
+    bool operator()(const SmallRegister& old_value, const SmallRegister& new_value)
+    {
+        auto changes{static_cast<Register>(old_value() ^ new_value())};
+        detail::for_each_changed_bitfield<Bits>(
+            changes, [&](auto position) { calls[position](handlers, old_value, new_value); });
+        return (changes & Bits::all) != 0;
+    }
+
+  private:
+    std::tuple<Handlers...> handlers;
+};
+
+//! Creates jungles::change_dispatcher for the SmallRegister with the handlers created with jungles::on().
+template<typename SmallRegister, typename... Handlers>
+constexpr change_dispatcher<SmallRegister, Handlers...> make_dispatcher(Handlers... handlers)
+{
+    return change_dispatcher<SmallRegister, Handlers...>{handlers...};
+}
+
+} // namespace jungles
+
+#endif /* REGISTER_DIFF_HPP */
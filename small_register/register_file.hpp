@@ -0,0 +1,196 @@
+/**
+ * @file	register_file.hpp
+ * @brief	Shadow copy of the registers described by a small_map, which tracks the modified registers.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef REGISTER_FILE_HPP
+#define REGISTER_FILE_HPP
+
+#include "small_register/small_map.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace jungles
+{
+
+template<typename SmallMap>
+class register_file;
+
+/**
+ * \brief Holds a value for each register of the jungles::small_map and tracks which registers were modified since
+ *        the last synchronization with the device.
+ *
+ * The registers are kept in a single contiguous object. A register is marked as modified (dirty) only when the stored
+ * value differs from the current one, so that flush() writes only the registers which actually changed.
+ *
+ * The access metadata of the bitfields is respected: fetch() doesn't read the write-only registers and keeps the
+ * written values of the write-only bitfields, and flush() writes ones only to the write-1-to-clear bits which were
+ * cleared since the last synchronization, see jungles::write_1_to_clear.
+ *
+ * The Bus used for the synchronization shall provide:
+ * - "void write(Address address, RegisterUnderlyingType value)" - used by flush(),
+ * - "RegisterUnderlyingType read(Address address)" - used by fetch(); the result is converted to the register type.
+ *
+ * \tparam SmallMap jungles::small_map template instance.
+ */
+template<typename... Elements>
+class register_file<small_map<Elements...>>
+{
+  private:
+    using Map = small_map<Elements...>;
+    using Registers = std::tuple<typename Elements::Register...>;
+
+    using Raws = std::tuple<typename Elements::Register::underlying_type...>;
+
+    template<auto Address>
+    static inline constexpr std::size_t index{Map::template register_from_address<Address>::index};
+
+    template<typename Register>
+    static inline constexpr auto flags{Register::template access_mask<field_access::write_1_to_clear>};
+
+  public:
+    //! Type of the register under the Address.
+    template<auto Address>
+    using register_type = typename Map::template register_from_address<Address>::type;
+
+    //! Constructs the file with the registers set to the reset values of the elements and not modified.
+    register_file() = default;
+
+    //! Returns the current value of the register.
+    template<auto Address>
+    const register_type<Address>& get() const
+    {
+        return std::get<index<Address>>(registers);
+    }
+
+    //! Stores the register value, marking the register as modified if the value differs from the current one.
+    template<auto Address>
+    void store(register_type<Address> value)
+    {
+        auto& current{std::get<index<Address>>(registers)};
+        if (current() != value())
+        {
+            using Register = register_type<Address>;
+            auto& to_clear{std::get<index<Address>>(flags_to_clear)};
+            to_clear = static_cast<typename Register::underlying_type>(
+                to_clear | (Register::written_value(current(), value()) & flags<Register>));
+            current = value;
+            dirty.set(index<Address>);
+        }
+    }
+
+    /**
+     * \brief Applies the function to a copy of the register and stores the result.
+     *
+     * E.g. "file.update<0x01>([](auto& r) { r.template assign<charge_control1::icc>(0b11001); });"
+     */
+    template<auto Address, typename Function>
+    void update(Function function)
+    {
+        auto value{get<Address>()};
+        function(value);
+        store<Address>(value);
+    }
+
+    //! Sets the register to the value obtained from the device, so the register is not considered modified.
+    template<auto Address>
+    void load(register_type<Address> value)
+    {
+        std::get<index<Address>>(registers) = value;
+        std::get<index<Address>>(flags_to_clear) = 0;
+        dirty.reset(index<Address>);
+    }
+
+    /**
+     * \brief Sets the registers to the reset values of the elements, not modified, e.g. after the device was reset, so
+     *        that the registers can be modified and flushed without fetching them first.
+     */
+    void reset()
+    {
+        (load<Elements::address>(Map::template reset_value<Elements::address>()), ...);
+    }
+
+    //! Tells whether the register was modified since the last synchronization.
+    template<auto Address>
+    bool is_dirty() const
+    {
+        return dirty.test(index<Address>);
+    }
+
+    //! Tells whether any register was modified since the last synchronization.
+    bool is_dirty() const
+    {
+        return dirty.any();
+    }
+
+    //! Marks all the registers as modified, e.g. to restore the whole configuration after the device was reset.
+    void mark_dirty()
+    {
+        dirty.set();
+    }
+
+    /**
+     * \brief Writes the modified registers to the bus, in the order of the map, and marks them as not modified.
+     * \returns Number of the registers written.
+     */
+    template<typename Bus>
+    std::size_t flush(Bus& bus)
+    {
+        return flush(bus, std::index_sequence_for<Elements...>{});
+    }
+
+    /**
+     * \brief Reads all the registers from the bus, except the write-only ones. Discards the modifications which weren't
+     *        flushed, except the values of the write-only bitfields, which can't be read.
+     */
+    template<typename Bus>
+    void fetch(Bus& bus)
+    {
+        (fetch<Elements::address>(bus), ...);
+    }
+
+  private:
+    template<auto Address, typename Bus>
+    void fetch(Bus& bus)
+    {
+        using Register = register_type<Address>;
+        using Raw = typename Register::underlying_type;
+        if constexpr (!detail::is_write_only<Register>)
+        {
+            constexpr auto written{Register::template access_mask<field_access::write_only>};
+            auto value{static_cast<Raw>(bus.read(Address))};
+            load<Address>(Register{static_cast<Raw>((value & ~written) | (get<Address>()() & written))});
+        }
+    }
+
+    template<typename Bus, std::size_t... Indices>
+    std::size_t flush(Bus& bus, std::index_sequence<Indices...>)
+    {
+        std::size_t writes{0};
+        auto write_if_dirty{[&](auto address, std::size_t index, auto reg, auto& to_clear) {
+            if (dirty.test(index))
+            {
+                using Raw = typename decltype(reg)::underlying_type;
+                bus.write(address, static_cast<Raw>((reg() & ~flags<decltype(reg)>) | to_clear));
+                to_clear = 0;
+                dirty.reset(index);
+                ++writes;
+            }
+        }};
+        (write_if_dirty(Elements::address, Indices, std::get<Indices>(registers), std::get<Indices>(flags_to_clear)),
+         ...);
+        return writes;
+    }
+
+    Registers registers{Map::template reset_value<Elements::address>()...};
+    //! The write-1-to-clear bits cleared since the last synchronization, to be written as ones.
+    Raws flags_to_clear{};
+    std::bitset<sizeof...(Elements)> dirty;
+};
+
+} // namespace jungles
+
+#endif /* REGISTER_FILE_HPP */
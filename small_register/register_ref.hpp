@@ -0,0 +1,148 @@
+/**
+ * @file	register_ref.hpp
+ * @brief	Non-owning view which applies the small_register operations directly to bytes in a buffer.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef REGISTER_REF_HPP
+#define REGISTER_REF_HPP
+
+#include "small_register/byte_order.hpp"
+#include "small_register/small_register_internal.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace jungles
+{
+
+/**
+ * \brief Views sizeof(underlying_type) bytes of a caller's buffer as the SmallRegister, e.g. a field of a received frame.
+ *
+ * Each operation loads the register from the buffer, with a single load and a byte swap when needed, applies the
+ * operation of the SmallRegister and stores the result back. No copy of the buffer is made, so frames can be decoded
+ * and patched in place:
+ *
+ *     register_ref<Header> header{frame + 2};
+ *     header.set<header_field::length>(payload_size).clear<header_field::checksum>();
+ *
+ * The methods mirror the ones of jungles::basic_small_register and return reference to the view, or the result of the
+ * operation if the jungles::overflow policy makes the operations return an error code.
+ *
+ * \tparam SmallRegister jungles::small_register template instance.
+ * \tparam Order Order of the bytes within the buffer.
+ */
+template<typename SmallRegister, byte_order Order = byte_order::big>
+class register_ref
+{
+  private:
+    using Register = typename SmallRegister::underlying_type;
+
+  public:
+    //! Type of the viewed register.
+    using register_type = SmallRegister;
+
+    //! Type of the viewed register value.
+    using underlying_type = Register;
+
+    /**
+     * Views the bytes starting from data, which shall remain valid for the lifetime of the view.
+     * \tparam Byte uint8_t, unsigned char, char or std::byte.
+     */
+    template<typename Byte>
+    explicit register_ref(Byte* data) : bytes{reinterpret_cast<uint8_t*>(data)}
+    {
+        static_assert(detail::is_byte<Byte>, "Registers can be viewed only within buffers of bytes");
+    }
+
+    //! Loads the register from the buffer.
+    SmallRegister load() const
+    {
+        return SmallRegister{detail::load<Order, Register>(bytes)};
+    }
+
+    //! Overwrites the bytes in the buffer with the register value.
+    register_ref& store(const SmallRegister& reg)
+    {
+        detail::store<Order>(reg(), bytes);
+        return *this;
+    }
+
+    //! Returns the raw value of the register.
+    Register operator()() const
+    {
+        return load()();
+    }
+
+    //! Returns the value of the specified bitfield, or a tuple of the values if multiple IDs are specified.
+    template<auto... Ids>
+    auto get() const
+    {
+        return load().template get<Ids...>();
+    }
+
+    //! See basic_small_register::set().
+    template<auto Id, auto... Ids>
+    register_ref& set()
+    {
+        return modify([](auto& reg) -> decltype(auto) { return reg.template set<Id, Ids...>(); });
+    }
+
+    //! See basic_small_register::set(values).
+    template<auto... Ids>
+    decltype(auto) set(typename detail::type_for<Register, Ids>::type... values)
+    {
+        return modify([&](auto& reg) -> decltype(auto) { return reg.template set<Ids...>(values...); });
+    }
+
+    //! See basic_small_register::assign().
+    template<auto Id, auto Value>
+    register_ref& assign()
+    {
+        return modify([](auto& reg) -> decltype(auto) { return reg.template assign<Id, Value>(); });
+    }
+
+    //! See basic_small_register::assign(values).
+    template<auto... Ids>
+    decltype(auto) assign(typename detail::type_for<Register, Ids>::type... values)
+    {
+        return modify([&](auto& reg) -> decltype(auto) { return reg.template assign<Ids...>(values...); });
+    }
+
+    //! See basic_small_register::clear().
+    template<auto Id, auto... Ids>
+    register_ref& clear()
+    {
+        return modify([](auto& reg) -> decltype(auto) { return reg.template clear<Id, Ids...>(); });
+    }
+
+    //! See basic_small_register::clear(masks).
+    template<auto... Ids>
+    decltype(auto) clear(typename detail::type_for<Register, Ids>::type... masks)
+    {
+        return modify([&](auto& reg) -> decltype(auto) { return reg.template clear<Ids...>(masks...); });
+    }
+
+  private:
+    //! Applies the operation to the loaded register and stores it back.
+    template<typename Operation>
+    decltype(auto) modify(Operation operation)
+    {
+        auto reg{load()};
+        if constexpr (std::is_same_v<decltype(operation(reg)), SmallRegister&>)
+        {
+            operation(reg);
+            return store(reg);
+        } else
+        {
+            auto result{operation(reg)};
+            store(reg);
+            return result;
+        }
+    }
+
+    uint8_t* bytes;
+};
+
+} // namespace jungles
+
+#endif /* REGISTER_REF_HPP */
@@ -6,27 +6,71 @@
 #ifndef SMALL_MAP_HPP
 #define SMALL_MAP_HPP
 
+#include "small_register/byte_order.hpp"
+#include "small_register/key_lookup.hpp"
 #include "small_register/small_register.hpp"
 #include "small_register/small_register_internal.hpp"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace jungles
 {
 
+namespace detail
+{
+
+template<typename Register, typename Raw, typename Visitor>
+void visit_register(Raw raw, Visitor& visitor)
+{
+    visitor(Register{static_cast<typename Register::underlying_type>(raw)});
+}
+
+template<typename Element, typename Raw, typename Visitor>
+void visit_element(Raw raw, Visitor& visitor)
+{
+    using Register = typename Element::Register;
+    visitor(Element{}, Register{static_cast<typename Register::underlying_type>(raw)});
+}
+
+//! Registers of the same type share the handler, unless the visitor needs the element, what helps branch prediction.
+template<typename Element, typename Raw, typename Visitor>
+constexpr auto visitor_for()
+{
+    using Register = typename Element::Register;
+    if constexpr (std::is_invocable_v<Visitor&, Element, Register>)
+        return &visit_element<Element, Raw, Visitor>;
+    else
+        return &visit_register<Register, Raw, Visitor>;
+}
+
+//! Whether none of the bits of the register can be read from the device.
+template<typename Register>
+inline constexpr bool is_write_only{Register::template access_mask<field_access::write_only>
+                                    == static_cast<typename Register::underlying_type>(
+                                        ~typename Register::underlying_type{0})};
+
+} // namespace detail
+
 /**
  * Element of the map that relates the Address to a type SmallRegister which shall be a template instance
  * of jungles::small_register.
  *
  * \note Must be used as an input to jungles:small_map template instantiation.
+ * \tparam Reset Value of the register after the device is reset, which lets the bus helpers skip reading the
+ *               registers whose value is known, see small_map::modify() and register_file::reset().
  */
-template<auto Address, typename SmallRegister>
+template<auto Address, typename SmallRegister, auto Reset = 0>
 struct element
 {
     static constexpr auto address{Address};
     using Register = SmallRegister;
+    static constexpr auto reset_value{Reset};
 };
 
 /**
@@ -38,26 +82,329 @@ struct small_map
 {
   private:
     static inline constexpr std::array addresses{Elements::address...};
-    static inline constexpr std::tuple<typename Elements::Register...> registers = {};
+
+    // Sorted once per map, so that each address lookup is a binary search instead of a linear one.
+    static inline constexpr auto address_index{detail::make_sorted_index(addresses)};
+
+    static_assert(detail::has_unique_keys(address_index), "Register addresses must be unique");
 
   public:
+    //! The jungles::element instances in the order of declaration.
+    using elements = std::tuple<Elements...>;
+
+    //! Number of registers in the map.
+    static inline constexpr std::size_t size{sizeof...(Elements)};
+
+    //! Type of the register addresses.
+    using address_type = typename decltype(addresses)::value_type;
+
     /**
      * \brief Performs the mapping at compile time. Use register_from_address::type alias to obtain the type.
+     *
+     * register_from_address::index is the position of the register within the map.
+     *
      * \tparam Register address (the value) that is key to obtain the type for that register address.
      */
     template<auto Address>
-    struct register_from_address
+    using register_from_address =
+        typename detail::map_lookup<detail::lookup(address_index, Address), Elements...>::type;
+
+    //! Returns the position of the register within the map.
+    template<auto Address>
+    static inline constexpr std::size_t position()
+    {
+        return register_from_address<Address>::index;
+    }
+
+    //! Returns the value of the register after the device is reset, see jungles::element.
+    template<auto Address>
+    static inline constexpr typename register_from_address<Address>::type reset_value()
+    {
+        using Register = typename register_from_address<Address>::type;
+        constexpr auto value{std::tuple_element_t<position<Address>(), elements>::reset_value};
+        static_assert(detail::is_in_range(value, static_cast<typename Register::underlying_type>(~0ull)),
+                      "Reset value doesn't fit the register");
+        return Register{static_cast<typename Register::underlying_type>(value)};
+    }
+
+    /**
+     * \brief Reads the registers over the Transport, merging the registers with adjacent addresses into bursts.
+     *
+     * Two registers are adjacent when the address of the latter equals the address of the former incremented by the
+     * size of the former in bytes, as for devices which auto-increment the address after each transferred byte.
+     * Multi-byte registers are transferred most significant byte first.
+     *
+     * The Transport shall provide "void read(Address first, uint8_t* data, std::size_t size)", which reads size
+     * bytes starting from the address first, in a single transaction.
+     *
+     * \tparam Addresses Addresses of the registers in ascending order.
+     * \returns The register, when one address is specified, or std::tuple of the registers otherwise.
+     */
+    template<auto... Addresses, typename Transport>
+    static auto read(Transport& transport)
+    {
+        static_assert((!detail::is_write_only<typename register_from_address<Addresses>::type> && ...),
+                      "Write-only register can't be read");
+        using Burst = burst<Addresses...>;
+
+        trace<Addresses...>(access::read);
+        std::array<uint8_t, Burst::total_size> buffer;
+        Burst::for_each_run([&](auto first_address, std::size_t offset, std::size_t size) {
+            transport.read(first_address, buffer.data() + offset, size);
+        });
+
+        return Burst::decode(buffer.data(), std::index_sequence_for<decltype(Addresses)...>{});
+    }
+
+    /**
+     * \brief Writes the registers over the Transport, merging the registers with adjacent addresses into bursts.
+     *
+     * See read() for the definition of adjacency. The Transport shall provide
+     * "void write(Address first, const uint8_t* data, std::size_t size)".
+     *
+     * \tparam Addresses Addresses of the registers in ascending order.
+     */
+    template<auto... Addresses, typename Transport>
+    static void write(Transport& transport, const typename register_from_address<Addresses>::type&... registers)
+    {
+        using Burst = burst<Addresses...>;
+
+        trace<Addresses...>(access::assign);
+        std::array<uint8_t, Burst::total_size> buffer;
+        Burst::encode(buffer.data(), std::index_sequence_for<decltype(Addresses)...>{}, registers...);
+
+        Burst::for_each_run([&](auto first_address, std::size_t offset, std::size_t size) {
+            transport.write(first_address, static_cast<const uint8_t*>(buffer.data() + offset), size);
+        });
+    }
+
+    /**
+     * \brief Reads the register over the Transport, calls the function with it and writes the result back.
+     *
+     * The read is skipped when the register has no read-write bitfields, e.g. when it is write-only or holds only
+     * read-only and write-1-to-clear bitfields. Then the function gets the reset value of the element, with the
+     * write-1-to-clear bits set. basic_small_register::written_value() is written, so that only the write-1-to-clear
+     * bits cleared by the function are cleared in the device. The Transport is as for read() and write().
+     *
+     * A register with both write-only and read-write bitfields is rejected at compile time, as the write-only bitfields
+     * read back are meaningless: pass their values with modify(transport, write_only_values, function).
+     *
+     * \returns Nothing, or the error code, if the function returns one, in which case nothing is written.
+     */
+    template<auto Address, typename Transport, typename Function>
+    static decltype(auto) modify(Transport& transport, Function function)
+    {
+        using Register = typename register_from_address<Address>::type;
+        static_assert(Register::template access_mask<field_access::read_write> == 0
+                          || Register::template access_mask<field_access::write_only> == 0,
+                      "Register has write-only bitfields, pass their values to modify()");
+        return modify_with<Address>(transport, reset_value<Address>(), function);
+    }
+
+    /**
+     * \brief As modify(transport, function), but the write-only bitfields are taken from write_only_values, e.g. the
+     *        register as last written, instead of being read back or taken from the reset value.
+     *
+     * E.g. "Map::modify<0x10>(bus, last_written, [](auto& reg) { reg.template set<ctrl::enable>(); });".
+     */
+    template<auto Address, typename Transport, typename Function>
+    static decltype(auto) modify(Transport& transport,
+                                 const typename register_from_address<Address>::type& write_only_values,
+                                 Function function)
+    {
+        return modify_with<Address>(transport, write_only_values, function);
+    }
+
+    /**
+     * \brief Constructs the register under the address, known only at runtime, from the raw value and calls the visitor.
+     *
+     * The visitor is called with the jungles::element and the register, if it accepts such arguments, e.g.
+     * "[](auto element, auto reg) { ... decltype(element)::address ... }", or with the register only otherwise.
+     * The raw value is converted to the underlying type of the register.
+     *
+     * The register is found through a table generated at compile time: indexed with the address offset from the lowest
+     * address, when the addresses are dense, or a perfect hash table otherwise. No chain of comparisons is performed.
+     *
+     * \returns false, without calling the visitor, when there is no register under the address; true otherwise.
+     */
+    template<typename Raw, typename Visitor>
+    static bool visit(address_type address, Raw raw, Visitor&& visitor)
+    {
+        static_assert(std::is_integral_v<Raw>, "Raw register value must be of integral type");
+
+        auto position{address_lookup::find(address)};
+        if (position == size)
+            return false;
+        visitor_table<Raw, std::remove_reference_t<Visitor>>[position](raw, visitor);
+        return true;
+    }
+
+  private:
+    //! The register is read unless it has no read-write bitfields; the write-only bitfields are taken from the values.
+    template<auto Address, typename Transport, typename Function>
+    static decltype(auto) modify_with(Transport& transport,
+                                      const typename register_from_address<Address>::type& write_only_values,
+                                      Function function)
+    {
+        using Register = typename register_from_address<Address>::type;
+        using Raw = typename Register::underlying_type;
+        constexpr auto flags{Register::template access_mask<field_access::write_1_to_clear>};
+        constexpr auto write_only_bits{Register::template access_mask<field_access::write_only>};
+
+        Register before;
+        if constexpr (Register::template access_mask<field_access::read_write> == 0)
+            before = Register{static_cast<Raw>((reset_value<Address>()() & ~write_only_bits)
+                                               | (write_only_values() & write_only_bits) | flags)};
+        else
+            before = Register{static_cast<Raw>((read<Address>(transport)() & ~write_only_bits)
+                                               | (write_only_values() & write_only_bits))};
+
+        auto after{before};
+        auto write_back{[&]() { write<Address>(transport, Register{Register::written_value(before(), after())}); }};
+        if constexpr (std::is_same_v<decltype(function(after)), std::errc>)
+        {
+            auto result{function(after)};
+            if (result == std::errc{})
+                write_back();
+            return result;
+        } else
+        {
+            function(after);
+            write_back();
+        }
+    }
+
+    //! Reports the transfers of the registers with jungles::instrumented policy to their tracers, keyed by the address.
+    template<auto... Addresses>
+    static void trace(access operation)
+    {
+        (trace_one<Addresses>(operation), ...);
+    }
+
+    template<auto Address>
+    static void trace_one([[maybe_unused]] access operation)
+    {
+        using Policy = typename register_from_address<Address>::type::overflow_policy;
+        if constexpr (detail::is_traced<Policy>)
+            Policy::tracer::template record<small_map, Address>(operation);
+    }
+
+    //! Runtime lookup of the position of the register from the address, generated only when visit() is used.
+    using address_lookup = detail::key_lookup<Elements::address...>;
+
+    template<typename Raw, typename Visitor>
+    static inline constexpr std::array<void (*)(Raw, Visitor&), size> visitor_table{
+        detail::visitor_for<Elements, Raw, Visitor>()...};
+
+    //! Compile-time layout of the registers transferred together.
+    template<auto... Addresses>
+    struct burst
     {
-      private:
-        static inline constexpr auto address_it{detail::find(std::begin(addresses), std::end(addresses), Address)};
-        static_assert(address_it != std::end(addresses), "Register address not found");
+        static_assert(sizeof...(Addresses) > 0, "At least one register address must be specified");
+
+        static inline constexpr std::size_t count{sizeof...(Addresses)};
+        static inline constexpr std::array requested{Addresses...};
+        static inline constexpr std::array<std::size_t, count> sizes{
+            sizeof(typename register_from_address<Addresses>::type::underlying_type)...};
+        static inline constexpr std::size_t total_size{detail::accumulate(std::begin(sizes), std::end(sizes), 0u)};
+
+        static_assert(std::is_integral_v<typename decltype(requested)::value_type>,
+                      "Register addresses must be of integral type to be transferred in bursts");
+        static_assert(detail::is_strictly_ascending(std::begin(requested), std::end(requested)),
+                      "Register addresses must be specified in ascending order");
+
+        static constexpr std::array<std::size_t, count> compute_offsets()
+        {
+            std::array<std::size_t, count> result{};
+            for (std::size_t i{1}; i < count; ++i)
+                result[i] = result[i - 1] + sizes[i - 1];
+            return result;
+        }
+
+        static inline constexpr auto offsets{compute_offsets()};
+
+        //! A sequence of adjacent registers, transferred in a single transaction.
+        struct run
+        {
+            std::size_t first_index;
+            std::size_t size;
+        };
+
+        static constexpr bool is_adjacent_to_previous(std::size_t i)
+        {
+            return static_cast<std::size_t>(requested[i] - requested[i - 1]) == sizes[i - 1];
+        }
+
+        static constexpr std::size_t count_runs()
+        {
+            std::size_t result{1};
+            for (std::size_t i{1}; i < count; ++i)
+                result += is_adjacent_to_previous(i) ? 0 : 1;
+            return result;
+        }
+
+        static inline constexpr std::size_t run_count{count_runs()};
+
+        static constexpr std::array<run, run_count> compute_runs()
+        {
+            std::array<run, run_count> result{};
+            std::size_t current{0};
+            result[0] = {0, sizes[0]};
+            for (std::size_t i{1}; i < count; ++i)
+            {
+                if (is_adjacent_to_previous(i))
+                    result[current].size += sizes[i];
+                else
+                    result[++current] = {i, sizes[i]};
+            }
+            return result;
+        }
+
+        static inline constexpr auto runs{compute_runs()};
+
+        /**
+         * Calls the function for each run of adjacent registers with: first address, offset in buffer, size. The runs
+         * are unrolled at compile time, so the sizes of the transfers are constants.
+         */
+        template<typename Function>
+        static void for_each_run(Function function)
+        {
+            for_each_run(function, std::make_index_sequence<run_count>{});
+        }
+
+        template<typename Function, std::size_t... Runs>
+        static void for_each_run(Function function, std::index_sequence<Runs...>)
+        {
+            (function(run_address<Runs>, offsets[runs[Runs].first_index], runs[Runs].size), ...);
+        }
+
+        // Otherwise the address is loaded from the array at runtime, as it's passed by value, not as a constant.
+        template<std::size_t Run>
+        static inline constexpr auto run_address{requested[runs[Run].first_index]};
 
-        static inline constexpr auto type_index{std::distance(std::begin(addresses), address_it)};
+        template<std::size_t... Indices>
+        static auto decode(const uint8_t* buffer, std::index_sequence<Indices...>)
+        {
+            if constexpr (count == 1)
+                return decode_one<Addresses...>(buffer);
+            else
+                return std::tuple{decode_one<Addresses>(buffer + offsets[Indices])...};
+        }
 
-        using ElementType = typename std::tuple_element<type_index, std::tuple<Elements...>>::type;
+        template<auto Address>
+        static auto decode_one(const uint8_t* data)
+        {
+            using Register = typename register_from_address<Address>::type;
+            return Register{detail::load<byte_order::big, typename Register::underlying_type>(data)};
+        }
 
-      public:
-        using type = typename ElementType::Register;
+        template<std::size_t... Indices>
+        static void encode(uint8_t* buffer,
+                           std::index_sequence<Indices...>,
+                           const typename register_from_address<Addresses>::type&... registers)
+        {
+            (detail::store<byte_order::big>(registers(), buffer + offsets[Indices]), ...);
+        }
     };
 };
 
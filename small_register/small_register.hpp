@@ -6,31 +6,164 @@
 #ifndef SMALL_REGISTER_HPP
 #define SMALL_REGISTER_HPP
 
+#include <array>
+#include <iterator>
+#include <ratio>
 #include <stdexcept>
+#include <tuple>
+#include <utility>
 
+#include "small_register/key_lookup.hpp"
 #include "small_register/small_register_internal.hpp"
+#include "small_register/small_register_policies.hpp"
 
 namespace jungles
 {
 
+/**
+ * \brief How the device lets the bitfield be accessed. See jungles::read_only, jungles::write_only and
+ *        jungles::write_1_to_clear.
+ */
+enum class field_access
+{
+    read_write,
+    read_only,
+    write_only,
+    //! Reads a flag which is cleared by writing one to it; writing zero has no effect.
+    write_1_to_clear
+};
+
 /**
  * \brief Describes a bitfield.
  * \note Must be used as an input to jungles:small_register template instantiation.
  * \tparam Id Should be an ID which is a number or enumeration.
  * \tparam Size Bit-size of the bitfield.
+ * \tparam Name Optional name used by the formatters, e.g. "inline constexpr char icc[]{"ICC"};" and
+ *              "bitfield<cc1::icc, 5, icc>". The formatters use the numeric ID when there is no name.
  */
-template<auto Id, unsigned Size>
+template<auto Id, unsigned Size, const char* Name = nullptr>
 struct bitfield
 {
     static inline constexpr auto id{Id};
     static inline constexpr auto size{Size};
+    static inline constexpr const char* name{Name};
+    static inline constexpr bool is_signed{false};
+    static inline constexpr field_access access{field_access::read_write};
+    using scale = std::ratio<1>;
+    using offset = std::ratio<0>;
+
+    //! A plain bitfield is accessed by index as an array of one element, see jungles::bitfield_array.
+    static inline constexpr unsigned element_size{Size};
+    static inline constexpr unsigned count{1};
+};
+
+/**
+ * \brief Describes Count identical bitfields of Size bits each, e.g. the pins of a GPIO port or channel enable bits.
+ *
+ * The elements are accessed with an index known at runtime: "r.get<gpio::direction>(pin)",
+ * "r.assign<gpio::direction>(pin, 1)", or all at once with basic_small_register::fill() and
+ * basic_small_register::elements(). The element 0 occupies the least significant bits of the array, as the pin 0 of
+ * a GPIO port occupies the bit 0. Without an index the array is accessed as a single bitfield of Size * Count bits.
+ */
+template<auto Id, unsigned Size, unsigned Count, const char* Name = nullptr>
+struct bitfield_array : bitfield<Id, Size * Count, Name>
+{
+    static_assert(Size > 0 && Count > 0, "Bitfield array must have elements of non-zero size");
+
+    static inline constexpr unsigned element_size{Size};
+    static inline constexpr unsigned count{Count};
+};
+
+/**
+ * \brief Describes an unsigned bitfield holding a physical quantity: raw value * Scale + Offset.
+ *
+ * E.g. "scaled_bitfield<sensor::temperature, 10, std::ratio<1, 2>, std::ratio<-40>>" for 0.5 degree per LSB, starting
+ * from -40 degrees. basic_small_register::get_as() and basic_small_register::set_from() do the conversions.
+ *
+ * \tparam Scale std::ratio, the weight of the least significant bit.
+ * \tparam Offset std::ratio, the physical value for the raw value of zero.
+ * \tparam Name Optional name used by the formatters, as for jungles::bitfield.
+ */
+template<auto Id,
+         unsigned Size,
+         typename Scale = std::ratio<1>,
+         typename Offset = std::ratio<0>,
+         const char* Name = nullptr>
+struct scaled_bitfield : bitfield<Id, Size, Name>
+{
+    using scale = Scale;
+    using offset = Offset;
+};
+
+//! Describes a bitfield holding a two's complement number, optionally scaled as jungles::scaled_bitfield.
+template<auto Id,
+         unsigned Size,
+         typename Scale = std::ratio<1>,
+         typename Offset = std::ratio<0>,
+         const char* Name = nullptr>
+struct signed_bitfield : scaled_bitfield<Id, Size, Scale, Offset, Name>
+{
+    static inline constexpr bool is_signed{true};
+};
+
+/**
+ * \brief Marks the bitfield as read-only, e.g. "read_only<bitfield<status::chg_stat, 2>>".
+ *
+ * set(), assign(), clear(), fill() and set_from() on the bitfield are rejected at compile time. Wraps any bitfield
+ * descriptor.
+ */
+template<typename Bitfield>
+struct read_only : Bitfield
+{
+    static inline constexpr field_access access{field_access::read_only};
+};
+
+/**
+ * \brief Marks the bitfield as write-only: the value read from the device is meaningless.
+ *
+ * Reading the bitfield with mmio_register::get() is rejected at compile time. jungles::register_file keeps the written
+ * value when fetching the register, and the registers with no other bitfields are updated without any read.
+ */
+template<typename Bitfield>
+struct write_only : Bitfield
+{
+    static inline constexpr field_access access{field_access::write_only};
+};
+
+/**
+ * \brief Marks the bitfield as write-1-to-clear, e.g. an interrupt flag: it can be only read and cleared.
+ *
+ * When a register is written to the device, e.g. by mmio_register::clear(), jungles::defer() or register_file::flush(),
+ * ones are written to the bits cleared in the register and zeros to the other write-1-to-clear bits, so that
+ * a read-modify-write doesn't clear the flags pending in the device. See basic_small_register::written_value().
+ */
+template<typename Bitfield>
+struct write_1_to_clear : Bitfield
+{
+    static inline constexpr field_access access{field_access::write_1_to_clear};
+};
+
+//! Describes a bitfield at runtime, see basic_small_register::fields.
+template<typename Id, typename Register>
+struct field_descriptor
+{
+    Id id;
+    //! Position of the least significant bit of the bitfield within the register.
+    unsigned shift;
+    unsigned width;
+    //! The non-shifted mask, which is also the maximum value the bitfield can store.
+    Register mask;
 };
 
 /**
  * \brief Simplifies bitfield handling and adds safe checks. Bitfields are in Big Endian order.
+ * \tparam OverflowPolicy Defines what happens when a value doesn't fit a bitfield. One of the jungles::overflow
+ *                        policies. Use jungles::small_register alias to get the default, throwing, policy.
  * \tparam RegisterUnderlyingType Underlying type of the register, which determines its size.
  *                                Use e.g. uint8_t, uint16_t, uint32_t ...
- * \tparam Bitfields jungles::bitfield template instances that describe the layout of the register.
+ * \tparam Bitfields jungles::bitfield, jungles::scaled_bitfield, jungles::signed_bitfield or jungles::bitfield_array
+ *                   template instances that describe the layout of the register, optionally wrapped with
+ *                   jungles::read_only, jungles::write_only or jungles::write_1_to_clear.
  *
  * \note There are a few static assertions performed when instantiating the template:
  * - Bitfield IDs shall be unique. Compiler raises "Bitfield IDs must be unique" otherwise.
@@ -43,10 +176,11 @@ struct bitfield
  *   was not registered through template instantiation then a compiler error is thrown: "Bitfield ID not found"
  *
  * All the mutating methods like set(), clear(), ... return reference to self so the mutating opperations can
- * be chained: "r.set<id1>().clear<id2>().set<id3>()"
+ * be chained: "r.set<id1>().clear<id2>().set<id3>()". The only exception is the jungles::overflow::return_error
+ * policy, under which the methods taking runtime values return std::errc.
  */
-template<typename RegisterUnderlyingType, typename... Bitfields>
-class small_register
+template<typename OverflowPolicy, typename RegisterUnderlyingType, typename... Bitfields>
+class basic_small_register
 {
   private:
     using AreTypesOfIdTheSame = detail::are_same<decltype(Bitfields::id)...>;
@@ -54,7 +188,8 @@ class small_register
     static_assert(AreTypesOfIdTheSame::value, "bitfield::id types shall be the same");
 
     using Register = RegisterUnderlyingType;
-    using Self = small_register<RegisterUnderlyingType, Bitfields...>;
+    using Self = basic_small_register<OverflowPolicy, RegisterUnderlyingType, Bitfields...>;
+    using Id = std::remove_cv_t<std::tuple_element_t<0, std::tuple<decltype(Bitfields::id)...>>>;
 
     static constexpr unsigned bit_size{sizeof(Register) * 8};
 
@@ -63,102 +198,607 @@ class small_register
     static inline constexpr unsigned accumulated_size{detail::accumulate(std::begin(sizes), std::end(sizes), 0)};
 
     static_assert(accumulated_size == bit_size, "Whole register must be allocated");
-    static_assert(detail::has_unique(std::begin(ids), std::end(ids)), "Bitfield IDs must be unique");
 
-    template<auto Id>
-    static inline constexpr auto find_index()
+    // The tables are computed once per register type, so that each bitfield access costs a binary search in the ID
+    // index and two array reads, instead of linear searches and accumulations repeated for each ID.
+    static inline constexpr auto id_index{detail::make_sorted_index(ids)};
+
+    static_assert(detail::has_unique_keys(id_index), "Bitfield IDs must be unique");
+
+    static constexpr std::array<unsigned, sizeof...(Bitfields)> compute_shifts()
+    {
+        std::array<unsigned, sizeof...(Bitfields)> result{};
+        unsigned shift{0};
+        for (auto i{sizes.size()}; i > 0; --i)
+        {
+            result[i - 1] = shift;
+            shift += sizes[i - 1];
+        }
+        return result;
+    }
+
+    static constexpr std::array<Register, sizeof...(Bitfields)> compute_masks()
     {
-        constexpr auto it{detail::find(std::begin(ids), std::end(ids), Id)};
-        static_assert(it != std::end(ids), "Bitfield ID not found");
-        return std::distance(std::begin(ids), it);
+        std::array<Register, sizeof...(Bitfields)> result{};
+        for (std::size_t i{0}; i < sizes.size(); ++i)
+            result[i] = sizes[i] >= bit_size ? static_cast<Register>(~Register{0})
+                                             : static_cast<Register>((Register{1} << sizes[i]) - 1);
+        return result;
     }
 
+    static inline constexpr auto shifts{compute_shifts()};
+    static inline constexpr auto masks{compute_masks()};
+    static inline constexpr std::array accesses{Bitfields::access...};
+
+    static constexpr Register compute_access_mask(field_access kind)
+    {
+        Register result{0};
+        for (std::size_t i{0}; i < accesses.size(); ++i)
+            if (accesses[i] == kind)
+                result = static_cast<Register>(result | (masks[i] << shifts[i]));
+        return result;
+    }
+
+    //! The descriptors in the order of declaration, followed by Extra descriptors of a zero-width bitfield.
+    template<std::size_t Extra, std::size_t... Indices>
+    static constexpr auto make_fields(std::index_sequence<Indices...>)
+    {
+        return std::array<field_descriptor<Id, Register>, sizeof...(Bitfields) + Extra>{
+            field_descriptor<Id, Register>{ids[Indices], shifts[Indices], sizes[Indices], masks[Indices]}...};
+    }
+
+    // The descriptor of a zero-width bitfield follows the others, so that get(id) needs no branch for unknown IDs.
+    static inline constexpr auto fields_with_sentinel{make_fields<1>(std::index_sequence_for<Bitfields...>{})};
+
+    //! Runtime lookup of the position of the bitfield from the ID, generated only when get(id) is used.
+    using id_lookup = detail::key_lookup<Bitfields::id...>;
+
     template<auto Id>
-    static inline constexpr auto find_corresponding_size()
+    static inline constexpr std::size_t find_index()
     {
-        constexpr auto index{find_index<Id>()};
-        return std::next(std::begin(sizes), index);
+        constexpr auto index{detail::lookup(id_index, Id)};
+        static_assert(index != sizeof...(Bitfields), "Bitfield ID not found");
+        return index;
     }
 
     template<auto Id>
-    static inline constexpr auto find_shift()
+    static inline constexpr unsigned find_shift()
     {
-        constexpr auto size_it{find_corresponding_size<Id>()};
-        return detail::accumulate(std::next(size_it, 1), std::end(sizes), 0);
+        return shifts[find_index<Id>()];
     }
 
     template<auto Id>
     static inline constexpr Register get_maximum_value()
     {
-        auto sizes_it{find_corresponding_size<Id>()};
-        auto bitsize{*sizes_it};
-        return (1 << bitsize) - 1;
+        return masks[find_index<Id>()];
+    }
+
+    // Variable templates force the compile-time evaluation also when used within fold expressions.
+    template<auto Id>
+    static inline constexpr Register bitfield_mask{get_maximum_value<Id>()};
+
+    template<auto Id>
+    static inline constexpr unsigned bitfield_shift{find_shift<Id>()};
+
+    template<auto Id>
+    static inline constexpr field_access bitfield_access{accesses[find_index<Id>()]};
+
+    //! Rejects setting and assigning the read-only and the write-1-to-clear bitfields.
+    template<auto... Ids>
+    static constexpr void check_settable()
+    {
+        static_assert(((bitfield_access<Ids> != field_access::read_only) && ...), "Bitfield is read-only");
+        static_assert(((bitfield_access<Ids> != field_access::write_1_to_clear) && ...),
+                      "Write-1-to-clear bitfield can be only cleared");
+    }
+
+    template<auto... Ids>
+    static constexpr void check_clearable()
+    {
+        static_assert(((bitfield_access<Ids> != field_access::read_only) && ...), "Bitfield is read-only");
+    }
+
+    //! Reports the operation on the bitfields to the tracer of jungles::instrumented policy. No code without a tracer.
+    template<auto... Ids>
+    static constexpr void trace(access operation)
+    {
+        if constexpr (detail::is_traced<OverflowPolicy>)
+            (OverflowPolicy::tracer::template record<Self, Ids>(operation), ...);
+    }
+
+    //! Reports jungles::access::overflow for each of the values which doesn't fit its bitfield.
+    template<auto... Ids>
+    static constexpr void trace_overflows([[maybe_unused]] typename detail::type_for<Register, Ids>::type... values)
+    {
+        if constexpr (detail::is_traced<OverflowPolicy>)
+            ((is_any_overflowing<Ids>(values) ? trace<Ids>(access::overflow) : void()), ...);
+    }
+
+    template<auto... Ids>
+    static inline constexpr Register shifted_mask()
+    {
+        static_assert(detail::has_unique_values<Ids...>(), "Bitfield IDs must be unique");
+        return static_cast<Register>((Register{0} | ... | (bitfield_mask<Ids> << bitfield_shift<Ids>)));
+    }
+
+    template<auto Id, auto Value>
+    static inline constexpr Register shifted_value()
+    {
+        static_assert(detail::is_in_range(Value, bitfield_mask<Id>), "Value doesn't fit the bitfield");
+        return static_cast<Register>(static_cast<Register>(Value) << bitfield_shift<Id>);
+    }
+
+    template<auto Id, auto Mask>
+    static inline constexpr Register shifted_clear_mask()
+    {
+        static_assert(detail::is_in_range(Mask, bitfield_mask<Id>), "Mask doesn't match the bitfield");
+        return static_cast<Register>(static_cast<Register>(Mask) << bitfield_shift<Id>);
+    }
+
+    //! ORs the values shifted to the positions of the corresponding bitfields into the base value.
+    template<auto... Ids>
+    static inline constexpr Register merged(Register base, typename detail::type_for<Register, Ids>::type... values)
+    {
+        return static_cast<Register>((base | ... | (values << bitfield_shift<Ids>)));
+    }
+
+    //! Distinguishes "set<Id, Value>()" from "set<Id1, Id2>()" by the type of the template parameters.
+    template<auto... Args>
+    static inline constexpr bool is_compile_time_value()
+    {
+        if constexpr (sizeof...(Args) == 1)
+            return (!std::is_same_v<decltype(Args), Id> && ...);
+        else
+            return false;
+    }
+
+    //! Maximum value of a single element of the bitfield, see jungles::bitfield_array.
+    template<auto Id>
+    static inline constexpr Register element_mask()
+    {
+        using Bitfield = detail::nth_type<find_index<Id>(), Bitfields...>;
+        return static_cast<Register>(bitfield_mask<Id> >> (Bitfield::size - Bitfield::element_size));
+    }
+
+    /**
+     * Checks the index and the value according to the policy, and calls the operation with the shifted mask of the
+     * element and the shifted, adjusted value. The shift is computed from the index, with no per-element code.
+     */
+    template<auto Id, typename Error, typename Operation>
+    constexpr decltype(auto) modify_element(access kind, std::size_t index, Register value, Operation operation)
+    {
+        using Bitfield = detail::nth_type<find_index<Id>(), Bitfields...>;
+        if (index < Bitfield::count)
+        {
+            constexpr auto mask{element_mask<Id>()};
+            const bool is_overflowing{value > mask};
+            trace<Id>(kind);
+            if constexpr (detail::is_traced<OverflowPolicy>)
+                if (is_overflowing)
+                    trace<Id>(access::overflow);
+
+            const auto shift{bitfield_shift<Id> + static_cast<unsigned>(index) * Bitfield::element_size};
+            return OverflowPolicy::template run<Error>(is_overflowing, *this, [&]() {
+                operation(static_cast<Register>(mask << shift),
+                          static_cast<Register>(OverflowPolicy::adjust(value, mask) << shift));
+            });
+        }
+        return OverflowPolicy::template run<index_out_of_range_error>(true, *this, []() {});
+    }
+
+    //! Merges the range checks of all the values into a single comparison.
+    template<auto... Ids>
+    static inline constexpr bool is_any_overflowing(typename detail::type_for<Register, Ids>::type... values)
+    {
+        return (0 | ... | (values & ~bitfield_mask<Ids>)) != 0;
     }
 
   public:
+    //! Policy used to handle the values that don't fit the bitfields.
+    using overflow_policy = OverflowPolicy;
+
+    //! The same register with a different jungles::overflow policy.
+    template<typename Policy>
+    using with_policy = basic_small_register<Policy, RegisterUnderlyingType, Bitfields...>;
+
+    //! Underlying type of the register.
+    using underlying_type = RegisterUnderlyingType;
+
+    //! The jungles::bitfield descriptors in the order of declaration.
+    using bitfields = std::tuple<Bitfields...>;
+
+    //! Number of bitfields the register is composed of.
+    static inline constexpr std::size_t bitfield_count{sizeof...(Bitfields)};
+
+    //! Type of the bitfield IDs.
+    using id_type = Id;
+
+    //! Descriptors of the bitfields in the order of declaration, for the code handling any bitfield at runtime.
+    static inline constexpr auto fields{make_fields<0>(std::index_sequence_for<Bitfields...>{})};
+
+    //! The descriptor of the bitfield: jungles::bitfield, jungles::scaled_bitfield or jungles::signed_bitfield.
+    template<auto Id>
+    using bitfield_type = detail::nth_type<find_index<Id>(), Bitfields...>;
+
+    //! Returns the position of the bitfield in the order of declaration.
+    template<auto Id>
+    static inline constexpr std::size_t position()
+    {
+        return find_index<Id>();
+    }
+
+    //! Returns the position of the least significant bit of the bitfield within the register.
+    template<auto Id>
+    static inline constexpr unsigned shift()
+    {
+        return find_shift<Id>();
+    }
+
+    //! Returns the non-shifted mask of the bitfield, which is also the maximum value the bitfield can store.
+    template<auto Id>
+    static inline constexpr Register mask()
+    {
+        return get_maximum_value<Id>();
+    }
+
+    //! Bits of the bitfields with the access, e.g. "access_mask<field_access::write_1_to_clear>".
+    template<field_access Access>
+    static inline constexpr Register access_mask{compute_access_mask(Access)};
+
+    /**
+     * \brief Returns the value to write to the device to change the register from before to after.
+     *
+     * The write-1-to-clear bits are ones where they were cleared, and zeros elsewhere, so that the flags which weren't
+     * cleared remain pending in the device. The other bits are taken from after.
+     */
+    static constexpr Register written_value(Register before, Register after)
+    {
+        constexpr auto flags{access_mask<field_access::write_1_to_clear>};
+        return static_cast<Register>((after & ~flags) | (before & ~after & flags));
+    }
+
     /**
      * Constructs the register with initial_value that is mapped to the defined bitfields. Initial value is zero
      * if not specified.
      */
-    constexpr small_register(Register initial_value = 0) : underlying_register{initial_value}
+    constexpr basic_small_register(Register initial_value = 0) : underlying_register{initial_value}
     {
     }
 
-    //! Sets all the bits of the bitfield to ones.
-    template<auto Id>
+    /**
+     * \brief Sets all the bits of the bitfields to ones. Multiple bitfields are set with a single "|=" operation.
+     *
+     * "set<Id, Value>()", where Value is not a bitfield ID, sets the bitfield to a value known at compile time. Whether
+     * the value fits the bitfield is checked with a static assertion, so no runtime check is performed, regardless of
+     * the policy. This form requires IDs of enumeration type, to be distinguishable from the value.
+     */
+    template<auto Id, auto... Ids>
     constexpr inline Self& set()
     {
-        constexpr auto value{get_maximum_value<Id>()};
-        return set<Id>(value);
+        if constexpr (is_compile_time_value<Ids...>())
+        {
+            check_settable<Id>();
+            trace<Id>(access::set);
+            constexpr auto value{shifted_value<Id, Ids...>()};
+            underlying_register |= value;
+        } else
+        {
+            check_settable<Id, Ids...>();
+            trace<Id, Ids...>(access::set);
+            constexpr auto value{shifted_mask<Id, Ids...>()};
+            underlying_register |= value;
+        }
+        return *this;
     }
 
     /**
-     * \brief Sets the bitfield to a specified value, that is equivalent to "|= value" operation on the bitfield.
-     * \throws overflow_error when value is bigger than the maximum value the bitfield can store.
+     * \brief Sets the bitfields to the specified values, that is equivalent to "|= value" operation on each bitfield.
+     *
+     * When multiple bitfields are specified, e.g. "r.set<id1, id2>(value1, value2)", the values are merged at compile
+     * time, so that the register is modified with a single "|=" operation, after a single range check.
+     *
+     * \throws overflow_error when any value is bigger than the maximum value the corresponding bitfield can store,
+     *         under the default policy. See jungles::overflow for the other behaviours.
      */
-    template<auto Id>
-    constexpr inline Self& set(RegisterUnderlyingType value)
+    template<auto... Ids>
+    constexpr inline decltype(auto) set(typename detail::type_for<Register, Ids>::type... values)
     {
-        constexpr auto max_value{get_maximum_value<Id>()};
-        if (value > max_value)
-            throw overflow_error{};
+        static_assert(sizeof...(Ids) > 0, "At least one bitfield ID must be specified");
+        check_settable<Ids...>();
 
-        constexpr auto shift{find_shift<Id>()};
-        underlying_register |= (value << shift);
+        trace<Ids...>(access::set);
+        trace_overflows<Ids...>(values...);
+        return OverflowPolicy::template run<overflow_error>(is_any_overflowing<Ids...>(values...), *this, [&]() {
+            underlying_register |= merged<Ids...>(0, OverflowPolicy::adjust(values, bitfield_mask<Ids>)...);
+        });
+    }
+
+    /**
+     * \brief Assigns the values to the bitfields, leaving the other bitfields unchanged.
+     *
+     * Equivalent to "r.clear<id1>().set<id1>(value1).clear<id2>().set<id2>(value2)...", but the masks and the values
+     * are merged, so that the register is read and written once, with a single range check.
+     *
+     * \throws overflow_error when any value is bigger than the maximum value the corresponding bitfield can store,
+     *         under the default policy. See jungles::overflow for the other behaviours.
+     */
+    template<auto... Ids>
+    constexpr inline decltype(auto) assign(typename detail::type_for<Register, Ids>::type... values)
+    {
+        static_assert(sizeof...(Ids) > 0, "At least one bitfield ID must be specified");
+        check_settable<Ids...>();
+
+        trace<Ids...>(access::assign);
+        trace_overflows<Ids...>(values...);
+        return OverflowPolicy::template run<overflow_error>(is_any_overflowing<Ids...>(values...), *this, [&]() {
+            constexpr auto mask{shifted_mask<Ids...>()};
+            underlying_register = merged<Ids...>(static_cast<Register>(underlying_register & ~mask),
+                                                 OverflowPolicy::adjust(values, bitfield_mask<Ids>)...);
+        });
+    }
+
+    //! Assigns a value known at compile time to the bitfield. See set<Id, Value>() for details.
+    template<auto Id, auto Value>
+    constexpr inline Self& assign()
+    {
+        static_assert(is_compile_time_value<Value>(), "Value shall not be of the bitfield ID type");
+        check_settable<Id>();
+
+        trace<Id>(access::assign);
+        constexpr auto mask{shifted_mask<Id>()};
+        constexpr auto value{shifted_value<Id, Value>()};
+        underlying_register = static_cast<Register>((underlying_register & ~mask) | value);
         return *this;
     }
 
     //! Returns the value of the specified bitfield.
     template<auto Id>
-    constexpr inline RegisterUnderlyingType get()
+    constexpr inline RegisterUnderlyingType get() const
     {
+        trace<Id>(access::read);
         constexpr auto mask{get_maximum_value<Id>()};
         constexpr auto shift{find_shift<Id>()};
         return (underlying_register >> shift) & mask;
     }
 
-    //! Clears the whole bitfield (sets all bits to zeros).
-    template<auto Id>
+    //! Returns the values of the specified bitfields as a tuple, in the order of the IDs, reading the register once.
+    template<auto Id1, auto Id2, auto... Ids>
+    constexpr inline auto get() const
+    {
+        const auto value{underlying_register};
+        return std::tuple{Self{value}.template get<Id1>(),
+                          Self{value}.template get<Id2>(),
+                          Self{value}.template get<Ids>()...};
+    }
+
+    /**
+     * \brief Returns the value of the bitfield with the ID known only at runtime.
+     *
+     * The bitfield is found through a table generated at compile time, so no chain of comparisons is performed, and
+     * the value is extracted with the shift and the mask from basic_small_register::fields. Returns zero when there is
+     * no bitfield with the ID, see find_field(). The read is reported to the tracer as jungles::access::read of the
+     * bitfield, as by get<Id>(); the unknown IDs aren't reported.
+     */
+    constexpr inline RegisterUnderlyingType get(id_type id) const
+    {
+        if constexpr (detail::is_traced<OverflowPolicy>)
+            ((id == Bitfields::id ? trace<Bitfields::id>(access::read) : void()), ...);
+        const auto& field{fields_with_sentinel[id_lookup::find(id)]};
+        return static_cast<Register>((underlying_register >> field.shift) & field.mask);
+    }
+
+    //! Returns the descriptor of the bitfield with the ID known only at runtime, or nullptr if there is none.
+    static constexpr const field_descriptor<id_type, Register>* find_field(id_type id)
+    {
+        auto position{id_lookup::find(id)};
+        return position == bitfield_count ? nullptr : &fields[position];
+    }
+
+    /**
+     * \brief Calls the visitor with each bitfield ID, as std::integral_constant, and the value of the bitfield, in the
+     *        order of declaration. The calls are unrolled at compile time.
+     *
+     * E.g. "r.for_each_field([](auto id, auto value) { log(r.find_field(id)->shift, value); });".
+     */
+    template<typename Visitor>
+    constexpr void for_each_field(Visitor&& visitor) const
+    {
+        (visitor(std::integral_constant<id_type, Bitfields::id>{}, get<Bitfields::id>()), ...);
+    }
+
+    /**
+     * \brief Returns the value of the bitfield converted to T, sign-extended for jungles::signed_bitfield and scaled
+     *        for jungles::scaled_bitfield. The conversion has no branches.
+     *
+     * Floating-point T gets the exact scaled value. Integral T gets the value rounded toward zero.
+     */
+    template<auto Id, typename T>
+    constexpr inline T get_as() const
+    {
+        return detail::to_physical<bitfield_type<Id>, T>(get<Id>());
+    }
+
+    /**
+     * \brief Assigns the value, converted back to the raw value of the bitfield with the inverse of get_as().
+     *
+     * Floating-point values are rounded to the nearest raw value.
+     *
+     * \throws overflow_error when the raw value doesn't fit the bitfield, under the default policy. See jungles::overflow
+     *         for the other behaviours.
+     */
+    template<auto Id, typename T>
+    constexpr inline decltype(auto) set_from(T value)
+    {
+        using Bitfield = bitfield_type<Id>;
+        constexpr auto minimum{detail::raw_minimum<Bitfield>()};
+        constexpr auto maximum{detail::raw_maximum<Bitfield>()};
+
+        check_settable<Id>();
+        auto raw{detail::from_physical<Bitfield>(value)};
+        trace<Id>(access::assign);
+        if constexpr (detail::is_traced<OverflowPolicy>)
+            if (raw < minimum || raw > maximum)
+                trace<Id>(access::overflow);
+        return OverflowPolicy::template run<overflow_error>(raw < minimum || raw > maximum, *this, [&]() {
+            auto bits{static_cast<Register>(OverflowPolicy::adjust_range(raw, minimum, maximum)) & bitfield_mask<Id>};
+            constexpr auto mask{shifted_mask<Id>()};
+            underlying_register =
+                static_cast<Register>((underlying_register & ~mask) | (bits << bitfield_shift<Id>));
+        });
+    }
+
+    /**
+     * \brief Clears the whole bitfields (sets all bits to zeros). Multiple bitfields are cleared with a single "&=".
+     *
+     * "clear<Id, Mask>()", where Mask is not a bitfield ID, clears the bitfield with a mask known at compile time,
+     * analogously to set<Id, Value>().
+     */
+    template<auto Id, auto... Ids>
     constexpr inline Self& clear()
     {
-        constexpr auto mask{get_maximum_value<Id>()};
-        return clear<Id>(mask);
+        if constexpr (is_compile_time_value<Ids...>())
+        {
+            check_clearable<Id>();
+            trace<Id>(access::clear);
+            constexpr auto mask{shifted_clear_mask<Id, Ids...>()};
+            underlying_register &= static_cast<Register>(~mask);
+        } else
+        {
+            check_clearable<Id, Ids...>();
+            trace<Id, Ids...>(access::clear);
+            constexpr auto mask{shifted_mask<Id, Ids...>()};
+            underlying_register &= static_cast<Register>(~mask);
+        }
+        return *this;
     }
 
     /**
-     * \brief Clears the bitfield applying the mask. That is equivalent to "&= ~(mask)" operation on the bitfield.
-     * \throws mask_not_matching_error when mask is bigger than the maximum value the bitfield can store.
+     * \brief Clears the bitfields applying the masks. That is equivalent to "&= ~(mask)" operation on each bitfield.
+     *
+     * Multiple bitfields are cleared with a single "&=" operation, after a single range check.
+     *
+     * \throws mask_not_matching_error when any mask is bigger than the maximum value the bitfield can store, under the
+     *         default policy. See jungles::overflow for the other behaviours.
+     */
+    template<auto... Ids>
+    constexpr inline decltype(auto) clear(typename detail::type_for<Register, Ids>::type... masks)
+    {
+        static_assert(sizeof...(Ids) > 0, "At least one bitfield ID must be specified");
+        check_clearable<Ids...>();
+
+        trace<Ids...>(access::clear);
+        trace_overflows<Ids...>(masks...);
+        return OverflowPolicy::template run<mask_not_matching_error>(
+            is_any_overflowing<Ids...>(masks...), *this, [&]() {
+                underlying_register &=
+                    static_cast<Register>(~merged<Ids...>(0, OverflowPolicy::adjust(masks, bitfield_mask<Ids>)...));
+            });
+    }
+
+    /**
+     * \brief Returns the element of the jungles::bitfield_array under the index known at runtime.
+     *
+     * \throws index_out_of_range_error when the index is out of range, under the default policy. Under the other
+     *         policies zero is returned. jungles::overflow::unchecked asserts in debug builds.
      */
     template<auto Id>
-    constexpr inline Self& clear(RegisterUnderlyingType mask)
+    constexpr inline RegisterUnderlyingType get(std::size_t index) const
     {
-        constexpr auto strongest_mask{get_maximum_value<Id>()};
-        if (mask > strongest_mask)
-            throw mask_not_matching_error{};
+        using Bitfield = bitfield_type<Id>;
+        if (index >= Bitfield::count)
+        {
+            Self copy{*this};
+            static_cast<void>(OverflowPolicy::template run<index_out_of_range_error>(true, copy, []() {}));
+            return 0;
+        }
 
-        constexpr auto shift{find_shift<Id>()};
-        underlying_register &= ~(mask << shift);
-        return *this;
+        trace<Id>(access::read);
+        const auto shift{bitfield_shift<Id> + static_cast<unsigned>(index) * Bitfield::element_size};
+        return static_cast<Register>((underlying_register >> shift) & element_mask<Id>());
+    }
+
+    /**
+     * \brief ORs the value into the element of the jungles::bitfield_array, see set(values).
+     *
+     * \throws index_out_of_range_error when the index is out of range, or overflow_error when the value doesn't fit the
+     *         element, under the default policy. Under the other policies an out of range index leaves the register
+     *         unchanged.
+     */
+    template<auto Id>
+    constexpr inline decltype(auto) set(std::size_t index, RegisterUnderlyingType value)
+    {
+        check_settable<Id>();
+        return modify_element<Id, overflow_error>(access::set, index, value, [&](Register, Register bits) {
+            underlying_register |= bits;
+        });
+    }
+
+    //! Assigns the value to the element of the jungles::bitfield_array. Checked as set(index, value).
+    template<auto Id>
+    constexpr inline decltype(auto) assign(std::size_t index, RegisterUnderlyingType value)
+    {
+        check_settable<Id>();
+        return modify_element<Id, overflow_error>(access::assign, index, value, [&](Register mask, Register bits) {
+            underlying_register = static_cast<Register>((underlying_register & ~mask) | bits);
+        });
+    }
+
+    //! Clears the bits of the mask in the element of the jungles::bitfield_array. Checked as clear(masks).
+    template<auto Id>
+    constexpr inline decltype(auto) clear(std::size_t index, RegisterUnderlyingType mask)
+    {
+        check_clearable<Id>();
+        return modify_element<Id, mask_not_matching_error>(access::clear, index, mask, [&](Register, Register bits) {
+            underlying_register &= static_cast<Register>(~bits);
+        });
+    }
+
+    /**
+     * \brief Assigns the value to all the elements of the jungles::bitfield_array with a single operation.
+     *
+     * \throws overflow_error when the value doesn't fit the element, under the default policy.
+     */
+    template<auto Id>
+    constexpr inline decltype(auto) fill(RegisterUnderlyingType value)
+    {
+        check_settable<Id>();
+        using Bitfield = bitfield_type<Id>;
+        constexpr auto mask{element_mask<Id>()};
+
+        // A one at the least significant bit of each element: the value multiplied by it is repeated in each element.
+        constexpr auto ones{[]() {
+            Register result{0};
+            for (unsigned i{0}; i < Bitfield::count; ++i)
+                result = static_cast<Register>(result | (Register{1} << (i * Bitfield::element_size)));
+            return result;
+        }()};
+
+        trace<Id>(access::assign);
+        if constexpr (detail::is_traced<OverflowPolicy>)
+            if (value > mask)
+                trace<Id>(access::overflow);
+        return OverflowPolicy::template run<overflow_error>(value > mask, *this, [&]() {
+            constexpr auto array_mask{shifted_mask<Id>()};
+            auto repeated{static_cast<Register>(static_cast<unsigned long long>(OverflowPolicy::adjust(value, mask))
+                                                * ones)};
+            underlying_register = static_cast<Register>((underlying_register & ~array_mask)
+                                                        | static_cast<Register>(repeated << bitfield_shift<Id>));
+        });
+    }
+
+    //! Returns all the elements of the jungles::bitfield_array, starting from the element 0.
+    template<auto Id>
+    constexpr inline std::array<RegisterUnderlyingType, bitfield_type<Id>::count> elements() const
+    {
+        using Bitfield = bitfield_type<Id>;
+        constexpr auto mask{element_mask<Id>()};
+
+        trace<Id>(access::read);
+        std::array<RegisterUnderlyingType, Bitfield::count> result{};
+        for (unsigned i{0}; i < Bitfield::count; ++i)
+            result[i] = static_cast<Register>((underlying_register >> (bitfield_shift<Id> + i * Bitfield::element_size))
+                                              & mask);
+        return result;
     }
 
     //! Returns the underlying value.
@@ -169,16 +809,70 @@ class small_register
 
     struct mask_not_matching_error : std::exception
     {
+        //! Returned instead of throwing under jungles::overflow::return_error policy.
+        static inline constexpr std::errc code{std::errc::invalid_argument};
     };
 
     struct overflow_error : std::exception
     {
+        //! Returned instead of throwing under jungles::overflow::return_error policy.
+        static inline constexpr std::errc code{std::errc::value_too_large};
+    };
+
+    //! Thrown when the index of the element of a jungles::bitfield_array is out of range.
+    struct index_out_of_range_error : std::exception
+    {
+        //! Returned instead of throwing under jungles::overflow::return_error policy.
+        static inline constexpr std::errc code{std::errc::result_out_of_range};
     };
 
   private:
     RegisterUnderlyingType underlying_register;
 };
 
+/**
+ * \brief jungles::basic_small_register which throws when a value doesn't fit a bitfield.
+ *
+ * Use "small_register<...>::with_policy<P>" or jungles::basic_small_register directly to select another
+ * jungles::overflow policy.
+ */
+template<typename RegisterUnderlyingType, typename... Bitfields>
+using small_register = basic_small_register<overflow::throw_error, RegisterUnderlyingType, Bitfields...>;
+
+//! A bitfield ID with the value known at compile time, passed to jungles::make(). Use the jungles::field variable.
+template<auto Id, auto Value>
+struct field_value
+{
+    static inline constexpr auto id{Id};
+    static inline constexpr auto value{Value};
+};
+
+//! The value of the bitfield for jungles::make(), e.g. "field<reg::icc, 0b10100>".
+template<auto Id, auto Value>
+inline constexpr field_value<Id, Value> field{};
+
+/**
+ * \brief Builds the register from the values of the bitfields known at compile time, with no runtime checks.
+ *
+ *     constexpr auto cc1{make<ChargeControl1>(field<cc1::icc, 0b10100>, field<cc1::ipre, 0b01>)};
+ *     std::integral_constant<uint8_t, cc1()> raw_value;
+ *
+ * The bitfields which are not specified are zeros. A value which doesn't fit its bitfield and a bitfield specified
+ * twice are rejected with static assertions. The result is a constant expression, whatever the overflow policy.
+ */
+template<typename SmallRegister, auto... Ids, auto... Values>
+constexpr SmallRegister make(field_value<Ids, Values>...)
+{
+    using Register = typename SmallRegister::underlying_type;
+
+    static_assert(detail::has_unique_values<Ids...>(), "Each bitfield can be specified only once");
+    static_assert((detail::is_in_range(Values, SmallRegister::template mask<Ids>()) && ...),
+                  "Value doesn't fit the bitfield");
+
+    return SmallRegister{static_cast<Register>(
+        (Register{0} | ... | (static_cast<Register>(Values) << SmallRegister::template shift<Ids>())))};
+}
+
 } // namespace jungles
 
 #endif /* SMALL_REGISTER_HPP */
@@ -0,0 +1,386 @@
+/**
+ * @file	small_register_batch.hpp
+ * @brief	Extracts bitfields from contiguous arrays of raw register values (structure-of-arrays unpacking), and
+ *          converts them to physical values.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef SMALL_REGISTER_BATCH_HPP
+#define SMALL_REGISTER_BATCH_HPP
+
+#include "small_register/small_register.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace jungles
+{
+
+namespace detail
+{
+
+template<unsigned Shift, typename T>
+inline void unpack_scalar(const T* first, const T* last, T* d_first, T mask)
+{
+    for (; first != last; ++first, ++d_first)
+        *d_first = static_cast<T>((*first >> Shift) & mask);
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+template<typename T>
+inline __m128i broadcast_sse2(T value)
+{
+    if constexpr (sizeof(T) == 1)
+        return _mm_set1_epi8(static_cast<char>(value));
+    else if constexpr (sizeof(T) == 2)
+        return _mm_set1_epi16(static_cast<short>(value));
+    else if constexpr (sizeof(T) == 4)
+        return _mm_set1_epi32(static_cast<int>(value));
+    else
+        return _mm_set1_epi64x(static_cast<long long>(value));
+}
+
+// 8-bit lanes have no shift instruction, but shifting the 16-bit lanes is equivalent after masking: bits that cross
+// over from the neighbouring byte land above the bitfield width and are cleared by the mask.
+template<unsigned Shift, typename T>
+inline __m128i shift_right_sse2(__m128i v)
+{
+    if constexpr (Shift == 0)
+        return v;
+    else if constexpr (sizeof(T) <= 2)
+        return _mm_srli_epi16(v, Shift);
+    else if constexpr (sizeof(T) == 4)
+        return _mm_srli_epi32(v, Shift);
+    else
+        return _mm_srli_epi64(v, Shift);
+}
+
+template<unsigned Shift, typename T>
+inline std::size_t unpack_sse2(const T* first, std::size_t count, T* d_first, T mask)
+{
+    constexpr std::size_t lanes{sizeof(__m128i) / sizeof(T)};
+    const auto vmask{broadcast_sse2(mask)};
+
+    std::size_t i{0};
+    for (; i + lanes <= count; i += lanes)
+    {
+        auto v{_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i))};
+        v = _mm_and_si128(shift_right_sse2<Shift, T>(v), vmask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d_first + i), v);
+    }
+    return i;
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+template<typename T>
+inline __m256i broadcast_avx2(T value)
+{
+    if constexpr (sizeof(T) == 1)
+        return _mm256_set1_epi8(static_cast<char>(value));
+    else if constexpr (sizeof(T) == 2)
+        return _mm256_set1_epi16(static_cast<short>(value));
+    else if constexpr (sizeof(T) == 4)
+        return _mm256_set1_epi32(static_cast<int>(value));
+    else
+        return _mm256_set1_epi64x(static_cast<long long>(value));
+}
+
+template<unsigned Shift, typename T>
+inline __m256i shift_right_avx2(__m256i v)
+{
+    if constexpr (Shift == 0)
+        return v;
+    else if constexpr (sizeof(T) <= 2)
+        return _mm256_srli_epi16(v, Shift);
+    else if constexpr (sizeof(T) == 4)
+        return _mm256_srli_epi32(v, Shift);
+    else
+        return _mm256_srli_epi64(v, Shift);
+}
+
+template<unsigned Shift, typename T>
+inline std::size_t unpack_avx2(const T* first, std::size_t count, T* d_first, T mask)
+{
+    constexpr std::size_t lanes{sizeof(__m256i) / sizeof(T)};
+    const auto vmask{broadcast_avx2(mask)};
+
+    std::size_t i{0};
+    for (; i + lanes <= count; i += lanes)
+    {
+        auto v{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i))};
+        v = _mm256_and_si256(shift_right_avx2<Shift, T>(v), vmask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d_first + i), v);
+    }
+    return i;
+}
+
+#endif
+
+#if defined(__ARM_NEON)
+
+template<unsigned Shift, typename T>
+inline std::size_t unpack_neon(const T* first, std::size_t count, T* d_first, T mask)
+{
+    constexpr std::size_t lanes{16 / sizeof(T)};
+
+    std::size_t i{0};
+    for (; i + lanes <= count; i += lanes)
+    {
+        if constexpr (sizeof(T) == 1)
+        {
+            auto v{vld1q_u8(reinterpret_cast<const uint8_t*>(first + i))};
+            if constexpr (Shift != 0)
+                v = vshrq_n_u8(v, Shift);
+            vst1q_u8(reinterpret_cast<uint8_t*>(d_first + i), vandq_u8(v, vdupq_n_u8(mask)));
+        } else if constexpr (sizeof(T) == 2)
+        {
+            auto v{vld1q_u16(reinterpret_cast<const uint16_t*>(first + i))};
+            if constexpr (Shift != 0)
+                v = vshrq_n_u16(v, Shift);
+            vst1q_u16(reinterpret_cast<uint16_t*>(d_first + i), vandq_u16(v, vdupq_n_u16(mask)));
+        } else if constexpr (sizeof(T) == 4)
+        {
+            auto v{vld1q_u32(reinterpret_cast<const uint32_t*>(first + i))};
+            if constexpr (Shift != 0)
+                v = vshrq_n_u32(v, Shift);
+            vst1q_u32(reinterpret_cast<uint32_t*>(d_first + i), vandq_u32(v, vdupq_n_u32(mask)));
+        } else
+        {
+            auto v{vld1q_u64(reinterpret_cast<const uint64_t*>(first + i))};
+            if constexpr (Shift != 0)
+                v = vshrq_n_u64(v, Shift);
+            vst1q_u64(reinterpret_cast<uint64_t*>(d_first + i), vandq_u64(v, vdupq_n_u64(mask)));
+        }
+    }
+    return i;
+}
+
+#endif
+
+template<unsigned Shift, typename T>
+inline void unpack(const T* first, const T* last, T* d_first, T mask)
+{
+    static_assert(std::is_unsigned_v<T>, "Batch unpacking requires an unsigned register underlying type");
+
+    const auto count{static_cast<std::size_t>(last - first)};
+#if defined(__AVX2__)
+    const auto done{unpack_avx2<Shift>(first, count, d_first, mask)};
+#elif defined(__SSE2__)
+    const auto done{unpack_sse2<Shift>(first, count, d_first, mask)};
+#elif defined(__ARM_NEON)
+    const auto done{unpack_neon<Shift>(first, count, d_first, mask)};
+#else
+    const std::size_t done{0};
+#endif
+    unpack_scalar<Shift>(first + done, last, d_first + done, mask);
+}
+
+template<typename Bitfield, unsigned Shift, typename T, typename U>
+inline void convert_scalar(const T* first, const T* last, U* d_first)
+{
+    constexpr auto mask{static_cast<T>(Bitfield::size >= sizeof(T) * 8 ? ~T{0} : (T{1} << Bitfield::size) - 1)};
+    for (; first != last; ++first, ++d_first)
+        *d_first = to_physical<Bitfield, U>(static_cast<T>((*first >> Shift) & mask));
+}
+
+//! Whether the bitfield can be converted to float within 32-bit vector lanes.
+template<typename Bitfield, typename T, typename U>
+inline constexpr bool is_convertible_in_lanes{std::is_same_v<U, float> && (sizeof(T) == 2 || sizeof(T) == 4)
+                                              && Bitfield::size <= (Bitfield::is_signed ? 32u : 31u)};
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+template<typename Bitfield, unsigned Shift, typename T>
+inline std::size_t convert_sse2(const T* first, std::size_t count, float* d_first)
+{
+    // The bitfield is moved to the top of the 32-bit lane, so that the right shift extends the sign.
+    // 16-bit registers are unpacked to the upper halves of the lanes.
+    constexpr int left{static_cast<int>((sizeof(T) == 2 ? 16 : 32) - Shift - Bitfield::size)};
+    constexpr int right{static_cast<int>(32 - Bitfield::size)};
+    const auto scale{_mm_set1_ps(static_cast<float>(Bitfield::scale::num) / static_cast<float>(Bitfield::scale::den))};
+    const auto offset{
+        _mm_set1_ps(static_cast<float>(Bitfield::offset::num) / static_cast<float>(Bitfield::offset::den))};
+
+    auto convert_lanes{[&](__m128i v, float* d) {
+        if constexpr (left != 0)
+            v = _mm_slli_epi32(v, left);
+        if constexpr (Bitfield::is_signed)
+            v = _mm_srai_epi32(v, right);
+        else
+            v = _mm_srli_epi32(v, right);
+        auto values{_mm_mul_ps(_mm_cvtepi32_ps(v), scale)};
+        if constexpr (Bitfield::offset::num != 0)
+            values = _mm_add_ps(values, offset);
+        _mm_storeu_ps(d, values);
+    }};
+
+    constexpr std::size_t lanes{sizeof(__m128i) / sizeof(T)};
+    std::size_t i{0};
+    for (; i + lanes <= count; i += lanes)
+    {
+        auto v{_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i))};
+        if constexpr (sizeof(T) == 2)
+        {
+            const auto zero{_mm_setzero_si128()};
+            convert_lanes(_mm_unpacklo_epi16(zero, v), d_first + i);
+            convert_lanes(_mm_unpackhi_epi16(zero, v), d_first + i + 4);
+        } else
+        {
+            convert_lanes(v, d_first + i);
+        }
+    }
+    return i;
+}
+
+#endif
+
+#if defined(__ARM_NEON)
+
+template<typename Bitfield, unsigned Shift, typename T>
+inline std::size_t convert_neon(const T* first, std::size_t count, float* d_first)
+{
+    constexpr int left{static_cast<int>(32 - Shift - Bitfield::size)};
+    constexpr int right{static_cast<int>(32 - Bitfield::size)};
+    constexpr std::size_t lanes{4};
+    const auto scale{static_cast<float>(Bitfield::scale::num) / static_cast<float>(Bitfield::scale::den)};
+    const auto offset{vdupq_n_f32(static_cast<float>(Bitfield::offset::num) / static_cast<float>(Bitfield::offset::den))};
+
+    std::size_t i{0};
+    for (; i + lanes <= count; i += lanes)
+    {
+        uint32x4_t v;
+        if constexpr (sizeof(T) == 2)
+            v = vmovl_u16(vld1_u16(reinterpret_cast<const uint16_t*>(first + i)));
+        else
+            v = vld1q_u32(reinterpret_cast<const uint32_t*>(first + i));
+        v = vshlq_u32(v, vdupq_n_s32(left));
+        float32x4_t values;
+        if constexpr (Bitfield::is_signed)
+            values = vcvtq_f32_s32(vshlq_s32(vreinterpretq_s32_u32(v), vdupq_n_s32(-right)));
+        else
+            values = vcvtq_f32_u32(vshlq_u32(v, vdupq_n_s32(-right)));
+        values = vmulq_n_f32(values, scale);
+        if constexpr (Bitfield::offset::num != 0)
+            values = vaddq_f32(values, offset);
+        vst1q_f32(d_first + i, values);
+    }
+    return i;
+}
+
+#endif
+
+template<typename Bitfield, unsigned Shift, typename T, typename U>
+inline void convert(const T* first, const T* last, U* d_first)
+{
+    static_assert(std::is_unsigned_v<T>, "Batch conversion requires an unsigned register underlying type");
+
+    const auto count{static_cast<std::size_t>(last - first)};
+    std::size_t done{0};
+    if constexpr (is_convertible_in_lanes<Bitfield, T, U>)
+    {
+#if defined(__AVX2__) || defined(__SSE2__)
+        done = convert_sse2<Bitfield, Shift>(first, count, d_first);
+#elif defined(__ARM_NEON)
+        done = convert_neon<Bitfield, Shift>(first, count, d_first);
+#endif
+    }
+    convert_scalar<Bitfield, Shift>(first + done, last, d_first + done);
+}
+
+//! Number of registers processed at once for all the bitfields, so that the input stays in L1 cache.
+inline constexpr std::size_t unpack_block_size{1024};
+
+template<typename SmallRegister, std::size_t... Indices>
+inline void unpack_all(const typename SmallRegister::underlying_type* first,
+                       const typename SmallRegister::underlying_type* last,
+                       const std::array<typename SmallRegister::underlying_type*, SmallRegister::bitfield_count>& d_firsts,
+                       std::index_sequence<Indices...>)
+{
+    using Bitfields = typename SmallRegister::bitfields;
+
+    for (std::size_t offset{0}; first + offset < last; offset += unpack_block_size)
+    {
+        auto block_last{(last - first - offset) > static_cast<std::ptrdiff_t>(unpack_block_size)
+                            ? first + offset + unpack_block_size
+                            : last};
+        (unpack<SmallRegister::template shift<std::tuple_element_t<Indices, Bitfields>::id>()>(
+             first + offset,
+             block_last,
+             d_firsts[Indices] + offset,
+             SmallRegister::template mask<std::tuple_element_t<Indices, Bitfields>::id>()),
+         ...);
+    }
+}
+
+} // namespace detail
+
+/**
+ * \brief Extracts a single bitfield from each raw register value in the range [first, last).
+ *
+ * Equivalent to constructing SmallRegister from every raw value and calling get<Id>() on it, but uses SSE2, AVX2 or
+ * NEON instructions when the target supports them. The output range starting at d_first shall have at least
+ * (last - first) elements.
+ *
+ * \tparam SmallRegister jungles::small_register template instance which describes the layout of the raw values.
+ * \tparam Id ID of the bitfield to extract.
+ */
+template<typename SmallRegister, auto Id>
+inline void unpack(const typename SmallRegister::underlying_type* first,
+                   const typename SmallRegister::underlying_type* last,
+                   typename SmallRegister::underlying_type* d_first)
+{
+    constexpr auto shift{SmallRegister::template shift<Id>()};
+    constexpr auto mask{SmallRegister::template mask<Id>()};
+    detail::unpack<shift>(first, last, d_first, mask);
+}
+
+/**
+ * \brief Extracts all the bitfields from each raw register value in the range [first, last) into separate arrays.
+ *
+ * \param d_firsts Beginnings of the output arrays, one for each bitfield, in the order of bitfield declaration.
+ *                 Each array shall have at least (last - first) elements.
+ */
+template<typename SmallRegister>
+inline void
+unpack_all(const typename SmallRegister::underlying_type* first,
+           const typename SmallRegister::underlying_type* last,
+           const std::array<typename SmallRegister::underlying_type*, SmallRegister::bitfield_count>& d_firsts)
+{
+    detail::unpack_all<SmallRegister>(
+        first, last, d_firsts, std::make_index_sequence<SmallRegister::bitfield_count>{});
+}
+
+/**
+ * \brief Converts a single bitfield of each raw register value in the range [first, last) to T, e.g. a FIFO of sensor
+ *        samples to an array of floats.
+ *
+ * Equivalent to constructing SmallRegister from every raw value and calling get_as<Id, T>() on it. The conversion to
+ * float of the bitfields of 16- and 32-bit registers uses SSE2 or NEON instructions when the target supports them.
+ * The output range starting at d_first shall have at least (last - first) elements.
+ */
+template<typename SmallRegister, auto Id, typename T>
+inline void convert(const typename SmallRegister::underlying_type* first,
+                    const typename SmallRegister::underlying_type* last,
+                    T* d_first)
+{
+    using Bitfield = typename SmallRegister::template bitfield_type<Id>;
+    constexpr auto shift{SmallRegister::template shift<Id>()};
+    detail::convert<Bitfield, shift>(first, last, d_first);
+}
+
+} // namespace jungles
+
+#endif /* SMALL_REGISTER_BATCH_HPP */
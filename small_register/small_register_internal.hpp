@@ -6,7 +6,13 @@
 #ifndef SMALL_REGISTER_INTERNAL_HPP
 #define SMALL_REGISTER_INTERNAL_HPP
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ratio>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace jungles
@@ -51,6 +57,192 @@ constexpr bool has_unique(InputIt first, InputIt last)
     return true;
 }
 
+template<auto... Values>
+constexpr bool has_unique_values()
+{
+    if constexpr (sizeof...(Values) == 0)
+    {
+        return true;
+    } else
+    {
+        constexpr std::array values{Values...};
+        return has_unique(std::begin(values), std::end(values));
+    }
+}
+
+template<typename InputIt>
+constexpr bool is_strictly_ascending(InputIt first, InputIt last)
+{
+    if (first == last)
+        return true;
+    for (auto next{first + 1}; next != last; ++first, ++next)
+    {
+        if (!(*first < *next))
+            return false;
+    }
+    return true;
+}
+
+//! Key of a compile-time index together with the position of the key in the original, unsorted, array.
+template<typename Key>
+struct index_entry
+{
+    Key key;
+    std::size_t position;
+};
+
+template<typename Key, std::size_t N>
+constexpr void sift_down(std::array<index_entry<Key>, N>& heap, std::size_t root, std::size_t count)
+{
+    for (auto child{2 * root + 1}; child < count; root = child, child = 2 * root + 1)
+    {
+        if (child + 1 < count && heap[child].key < heap[child + 1].key)
+            ++child;
+        if (!(heap[root].key < heap[child].key))
+            return;
+        auto tmp{heap[root]};
+        heap[root] = heap[child];
+        heap[child] = tmp;
+    }
+}
+
+/**
+ * \brief Creates an index of the keys sorted in ascending order, which allows O(log N) lookup at compile time.
+ *
+ * Heap sort is used, as it takes O(N log N) steps of constant evaluation, what matters for maps with hundreds of keys.
+ */
+template<typename Key, std::size_t N>
+constexpr std::array<index_entry<Key>, N> make_sorted_index(const std::array<Key, N>& keys)
+{
+    std::array<index_entry<Key>, N> index{};
+    for (std::size_t i{0}; i < N; ++i)
+        index[i] = {keys[i], i};
+
+    for (auto i{N / 2}; i > 0; --i)
+        sift_down(index, i - 1, N);
+    for (auto last{N}; last > 1; --last)
+    {
+        auto tmp{index[0]};
+        index[0] = index[last - 1];
+        index[last - 1] = tmp;
+        sift_down(index, 0, last - 1);
+    }
+    return index;
+}
+
+/**
+ * \brief Returns the position of the value in the original array or N if the value is not present in the index.
+ *
+ * As for "==", the value can be of another integral type than the keys; a value which the key type can't represent
+ * isn't present.
+ */
+template<typename Key, std::size_t N, typename T>
+constexpr std::size_t lookup(const std::array<index_entry<Key>, N>& index, T value)
+{
+    if constexpr (std::is_integral_v<Key> && std::is_integral_v<T> && !std::is_same_v<Key, T>)
+    {
+        if (static_cast<T>(static_cast<Key>(value)) != value || (value < T{}) != (static_cast<Key>(value) < Key{}))
+            return N;
+    }
+    auto key{static_cast<Key>(value)};
+
+    std::size_t first{0};
+    for (auto count{N}; count > 0;)
+    {
+        auto step{count / 2};
+        if (index[first + step].key < key)
+        {
+            first += step + 1;
+            count -= step + 1;
+        } else
+        {
+            count = step;
+        }
+    }
+    return first != N && index[first].key == key ? index[first].position : N;
+}
+
+template<typename Key, std::size_t N>
+constexpr bool has_unique_keys(const std::array<index_entry<Key>, N>& index)
+{
+    for (std::size_t i{1}; i < N; ++i)
+    {
+        if (index[i - 1].key == index[i].key)
+            return false;
+    }
+    return true;
+}
+
+template<std::size_t Index, typename T>
+struct indexed_type
+{
+    using type = T;
+};
+
+template<typename Indices, typename... Ts>
+struct indexed_types;
+
+template<std::size_t... Indices, typename... Ts>
+struct indexed_types<std::index_sequence<Indices...>, Ts...> : indexed_type<Indices, Ts>...
+{
+};
+
+template<std::size_t Index, typename T>
+indexed_type<Index, T> select_indexed_type(const indexed_type<Index, T>&);
+
+/**
+ * \brief The type at the position Index within the pack Ts.
+ *
+ * Equivalent to std::tuple_element_t<Index, std::tuple<Ts...>>, but the lookup is done through overload resolution
+ * instead of recursive instantiation, so it doesn't hit the template instantiation depth limit for large packs. The call
+ * is qualified to disable argument-dependent lookup, which would instantiate all the types of the pack.
+ */
+template<std::size_t Index, typename... Ts>
+using nth_type = typename decltype(detail::select_indexed_type<Index>(
+    std::declval<indexed_types<std::index_sequence_for<Ts...>, Ts...>>()))::type;
+
+//! Result of the lookup of an address within jungles::small_map.
+template<std::size_t Index, typename Register>
+struct map_entry
+{
+    using type = Register;
+    static inline constexpr std::size_t index{Index};
+};
+
+/**
+ * \brief Finds the element at the Index, which is the result of the lookup of the address in the sorted index.
+ *
+ * The resulting map_entry doesn't depend on all the Elements. Static members of a type parametrized with all the
+ * Elements would have the whole map in their mangled names, what makes each lookup cost O(N) in the compiler backend.
+ */
+template<std::size_t Index, typename... Elements>
+struct map_lookup
+{
+    static_assert(Index != sizeof...(Elements), "Register address not found");
+
+    // Index 0 avoids a second, confusing, error when the address is not found.
+    using type = map_entry<Index, typename nth_type<(Index != sizeof...(Elements) ? Index : 0), Elements...>::Register>;
+};
+
+//! Checks whether a value, possibly of a signed type, lies in the range [0, max].
+template<typename T, typename U>
+constexpr bool is_in_range(T value, U max)
+{
+    if constexpr (std::is_signed_v<T>)
+    {
+        if (value < 0)
+            return false;
+    }
+    return static_cast<unsigned long long>(value) <= static_cast<unsigned long long>(max);
+}
+
+//! Maps any non-type template parameter to T, to allow expanding a pack of function parameters from a pack of IDs.
+template<typename T, auto>
+struct type_for
+{
+    using type = T;
+};
+
 template<class T, class... Ts>
 struct are_same_impl : std::conjunction<std::is_same<T, Ts>...>
 {
@@ -61,6 +253,103 @@ struct are_same : are_same_impl<std::tuple_element_t<0, std::tuple<Ts...>>, Ts..
 {
 };
 
+//! Smallest raw value of the bitfield, as a two's complement number for the signed bitfields.
+template<typename Bitfield>
+constexpr long long raw_minimum()
+{
+    return Bitfield::is_signed ? -(1LL << (Bitfield::size - 1)) : 0;
+}
+
+//! Largest raw value of the bitfield, as a two's complement number for the signed bitfields.
+template<typename Bitfield>
+constexpr long long raw_maximum()
+{
+    static_assert(Bitfield::is_signed || Bitfield::size < 64,
+                  "Unsigned bitfields of 64 bits can't be converted from other types");
+    return (1LL << (Bitfield::size - (Bitfield::is_signed ? 1 : 0))) - 1;
+}
+
+//! Sign-extends the raw value of a signed bitfield, without branches.
+template<typename Bitfield, typename Register>
+constexpr auto sign_extend(Register raw)
+{
+    if constexpr (!Bitfield::is_signed)
+        return raw;
+    else if constexpr (Bitfield::size == 64)
+        return static_cast<long long>(raw);
+    else if constexpr (Bitfield::size == 32)
+        return static_cast<int32_t>(raw);
+    else if constexpr (Bitfield::size < 32)
+    {
+        // Narrower than long long, so that the conversion to floating-point can be vectorized.
+        constexpr auto sign_bit{static_cast<int32_t>(1L << (Bitfield::size - 1))};
+        return (static_cast<int32_t>(raw) ^ sign_bit) - sign_bit;
+    } else
+    {
+        constexpr auto sign_bit{1LL << (Bitfield::size - 1)};
+        return (static_cast<long long>(raw) ^ sign_bit) - sign_bit;
+    }
+}
+
+//! Converts the raw value of the bitfield to the physical value, applying the scale and the offset of the bitfield.
+template<typename Bitfield, typename T, typename Register>
+constexpr T to_physical(Register raw)
+{
+    using Scale = typename Bitfield::scale;
+    using Offset = typename Bitfield::offset;
+
+    auto value{sign_extend<Bitfield>(raw)};
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        constexpr auto scale{static_cast<T>(Scale::num) / static_cast<T>(Scale::den)};
+        constexpr auto offset{static_cast<T>(Offset::num) / static_cast<T>(Offset::den)};
+        // Adding zero can't be optimized out, as it turns -0 into +0.
+        if constexpr (Offset::num == 0)
+            return static_cast<T>(static_cast<T>(value) * scale);
+        else
+            return static_cast<T>(static_cast<T>(value) * scale + offset);
+    } else if constexpr (Scale::den == 1 && Offset::den == 1)
+    {
+        return static_cast<T>(static_cast<T>(value) * static_cast<T>(Scale::num) + static_cast<T>(Offset::num));
+    } else
+    {
+        // Common denominator of the scale and the offset. Rounds toward zero.
+        constexpr auto denominator{Scale::den * Offset::den};
+        return static_cast<T>((static_cast<long long>(value) * Scale::num * Offset::den + Offset::num * Scale::den)
+                              / denominator);
+    }
+}
+
+/**
+ * \brief Converts the physical value to the raw value of the bitfield. Not range-checked.
+ *
+ * Floating-point values are rounded to the nearest integer, and NaN is converted to a value out of the range of any
+ * bitfield, so that it overflows. Integral values are rounded toward zero.
+ */
+template<typename Bitfield, typename T>
+constexpr long long from_physical(T value)
+{
+    using Scale = typename Bitfield::scale;
+    using Offset = typename Bitfield::offset;
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        constexpr auto scale{static_cast<T>(Scale::num) / static_cast<T>(Scale::den)};
+        constexpr auto offset{static_cast<T>(Offset::num) / static_cast<T>(Offset::den)};
+        // Limited to the range of long long, within which the conversion is defined.
+        constexpr auto limit{static_cast<T>(1LL << 62)};
+        auto raw{(value - offset) / scale};
+        if (raw != raw)
+            return static_cast<long long>(limit);
+        raw = raw < -limit ? -limit : (raw > limit ? limit : raw);
+        return static_cast<long long>(raw < 0 ? raw - T{0.5} : raw + T{0.5});
+    } else
+    {
+        return (static_cast<long long>(value) * Scale::den * Offset::den - Offset::num * Scale::den)
+               / (Scale::num * Offset::den);
+    }
+}
+
 } // namespace detail
 
 } // namespace jungles
@@ -0,0 +1,210 @@
+/**
+ * @file	small_register_policies.hpp
+ * @brief	Policies that define how jungles::basic_small_register handles values which don't fit the bitfields.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef SMALL_REGISTER_POLICIES_HPP
+#define SMALL_REGISTER_POLICIES_HPP
+
+#include <cassert>
+#include <system_error>
+#include <type_traits>
+
+namespace jungles
+{
+
+/**
+ * \brief Policies for handling values that are bigger than the maximum value a bitfield can store.
+ *
+ * Each policy defines:
+ * - adjust(value, max) which is applied to each value before it is written to the register,
+ * - adjust_range(value, min, max) which is applied to the raw values converted by set_from(), which may be negative;
+ *   the number of values in [min, max] is a power of two,
+ * - run<Error>(is_overflowing, self, operation) which performs the operation and returns the result of the mutating
+ *   method. Error is basic_small_register::overflow_error, basic_small_register::mask_not_matching_error or
+ *   basic_small_register::index_out_of_range_error.
+ *
+ * Only throw_error uses exceptions, so the other policies can be used with "-fno-exceptions".
+ */
+namespace overflow
+{
+
+//! Throws overflow_error or mask_not_matching_error. This is the default policy.
+struct throw_error
+{
+    template<typename T>
+    static constexpr T adjust(T value, T)
+    {
+        return value;
+    }
+
+    template<typename T>
+    static constexpr T adjust_range(T value, T, T)
+    {
+        return value;
+    }
+
+    template<typename Error, typename Self, typename Operation>
+    static constexpr Self& run(bool is_overflowing, Self& self, Operation operation)
+    {
+        if (is_overflowing)
+            throw Error{};
+        operation();
+        return self;
+    }
+};
+
+/**
+ * \brief Leaves the register unchanged on overflow and returns an error code instead of reference to self.
+ *
+ * The mutating methods return std::errc::value_too_large on overflow, std::errc::invalid_argument when the mask is
+ * not matching the bitfield, and value-initialized std::errc on success.
+ */
+struct return_error
+{
+    template<typename T>
+    static constexpr T adjust(T value, T)
+    {
+        return value;
+    }
+
+    template<typename T>
+    static constexpr T adjust_range(T value, T, T)
+    {
+        return value;
+    }
+
+    template<typename Error, typename Self, typename Operation>
+    [[nodiscard]] static constexpr std::errc run(bool is_overflowing, Self&, Operation operation)
+    {
+        if (is_overflowing)
+            return Error::code;
+        operation();
+        return std::errc{};
+    }
+};
+
+//! Drops the bits of the value that don't fit the bitfield.
+struct truncate
+{
+    template<typename T>
+    static constexpr T adjust(T value, T max)
+    {
+        return value & max;
+    }
+
+    //! Wraps the value around the range, as two's complement numbers are truncated.
+    template<typename T>
+    static constexpr T adjust_range(T value, T min, T max)
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+        auto span_mask{static_cast<Unsigned>(static_cast<Unsigned>(max) - static_cast<Unsigned>(min))};
+        auto wrapped{static_cast<Unsigned>(static_cast<Unsigned>(value) - static_cast<Unsigned>(min)) & span_mask};
+        return static_cast<T>(wrapped + static_cast<Unsigned>(min));
+    }
+
+    template<typename Error, typename Self, typename Operation>
+    static constexpr Self& run(bool, Self& self, Operation operation)
+    {
+        operation();
+        return self;
+    }
+};
+
+//! Clamps the value to the maximum value the bitfield can store.
+struct saturate
+{
+    template<typename T>
+    static constexpr T adjust(T value, T max)
+    {
+        return value > max ? max : value;
+    }
+
+    template<typename T>
+    static constexpr T adjust_range(T value, T min, T max)
+    {
+        return value < min ? min : (value > max ? max : value);
+    }
+
+    template<typename Error, typename Self, typename Operation>
+    static constexpr Self& run(bool, Self& self, Operation operation)
+    {
+        operation();
+        return self;
+    }
+};
+
+/**
+ * \brief Performs no checks in release builds. Overflow is detected with assert() in debug builds.
+ *
+ * The bits of the value that don't fit the bitfield corrupt the neighbouring bitfields, so use it only when the values
+ * are known to fit.
+ */
+struct unchecked
+{
+    template<typename T>
+    static constexpr T adjust(T value, T)
+    {
+        return value;
+    }
+
+    template<typename T>
+    static constexpr T adjust_range(T value, T, T)
+    {
+        return value;
+    }
+
+    template<typename Error, typename Self, typename Operation>
+    static constexpr Self& run([[maybe_unused]] bool is_overflowing, Self& self, Operation operation)
+    {
+        assert(!is_overflowing && "Value doesn't fit the bitfield");
+        operation();
+        return self;
+    }
+};
+
+} // namespace overflow
+
+//! Operations on the bitfields reported to the tracers of jungles::instrumented registers.
+enum class access
+{
+    read,
+    set,
+    clear,
+    assign,
+    overflow
+};
+
+/**
+ * \brief Overflow policy which additionally reports every operation on each bitfield to the Tracer.
+ *
+ * The Tracer shall provide "template<typename Register, auto Id> static void record(access)", see e.g.
+ * jungles::field_counters. When the Tracer is void, the policy behaves exactly as the Policy, and the tracing compiles
+ * to nothing, so that the instrumentation can be switched with the build configuration:
+ *
+ *     using Tracer = std::conditional_t<is_debug_build, field_counters<>, void>;
+ *     using Status = basic_small_register<instrumented<overflow::throw_error, Tracer>, uint8_t, ...>;
+ *
+ * \tparam Policy One of the jungles::overflow policies.
+ */
+template<typename Policy, typename Tracer>
+struct instrumented : Policy
+{
+    using tracer = Tracer;
+};
+
+namespace detail
+{
+
+template<typename Policy, typename = void>
+inline constexpr bool is_traced{false};
+
+template<typename Policy>
+inline constexpr bool is_traced<Policy, std::void_t<typename Policy::tracer>>{
+    !std::is_void_v<typename Policy::tracer>};
+
+} // namespace detail
+
+} // namespace jungles
+
+#endif /* SMALL_REGISTER_POLICIES_HPP */
@@ -0,0 +1,392 @@
+/**
+ * @file	wide_register.hpp
+ * @brief	Registers wider than the largest built-in integer, backed by arrays of words or bytes.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef WIDE_REGISTER_HPP
+#define WIDE_REGISTER_HPP
+
+#include "small_register/byte_order.hpp"
+#include "small_register/small_register.hpp"
+#include "small_register/small_register_internal.hpp"
+#include "small_register/small_register_policies.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace jungles
+{
+
+template<typename OverflowPolicy, typename Storage, typename... Bitfields>
+class basic_wide_register;
+
+/**
+ * \brief Register of any size, e.g. a 96-bit protocol header or a 48-bit ADC frame, with bitfields of up to 64 bits,
+ *        which may span the boundaries of the words.
+ *
+ * Bitfields are in Big Endian order, as for jungles::small_register: the first bitfield occupies the most significant
+ * bits. The words of the array are in Big Endian order as well, so the first word is the most significant one, and
+ * byte arrays can be filled directly with the bytes received over the wire.
+ *
+ * The access to each bitfield is generated at compile time:
+ * - for arrays of std::uint64_t each bitfield spans at most two words,
+ * - arrays of bytes (std::uint8_t or std::byte) are accessed through unaligned 64-bit Big Endian loads and stores, so
+ *   each bitfield is accessed with at most two of them, as well,
+ * - for arrays of std::uint16_t and std::uint32_t a bitfield is accessed word by word.
+ *
+ * \tparam OverflowPolicy One of the jungles::overflow policies. Use jungles::wide_register alias for the default one.
+ * \tparam Word Type of the elements of the array backing the register.
+ * \tparam N Number of the elements of the array backing the register.
+ * \tparam Bitfields jungles::bitfield template instances that describe the layout of the register.
+ */
+template<typename OverflowPolicy, typename Word, std::size_t N, typename... Bitfields>
+class basic_wide_register<OverflowPolicy, std::array<Word, N>, Bitfields...>
+{
+  private:
+    using AreTypesOfIdTheSame = detail::are_same<decltype(Bitfields::id)...>;
+
+    static_assert(AreTypesOfIdTheSame::value, "bitfield::id types shall be the same");
+    static_assert(std::is_unsigned_v<Word> || std::is_same_v<Word, std::byte>,
+                  "Wide registers shall be backed by arrays of unsigned integers or bytes");
+
+    using Storage = std::array<Word, N>;
+    using Self = basic_wide_register<OverflowPolicy, Storage, Bitfields...>;
+    using Value = std::uint64_t;
+
+    static inline constexpr bool is_byte_array{sizeof(Word) == 1};
+    static inline constexpr std::size_t word_bits{sizeof(Word) * 8};
+    static inline constexpr std::size_t bit_size{N * word_bits};
+
+    static inline constexpr std::array ids{Bitfields::id...};
+    static inline constexpr std::array sizes{Bitfields::size...};
+    static inline constexpr std::size_t accumulated_size{
+        detail::accumulate(std::begin(sizes), std::end(sizes), std::size_t{0})};
+
+    static_assert(accumulated_size == bit_size, "Whole register must be allocated");
+    static_assert(((Bitfields::size <= 64) && ...), "Bitfields wider than 64 bits are not supported");
+
+    static inline constexpr auto id_index{detail::make_sorted_index(ids)};
+
+    static_assert(detail::has_unique_keys(id_index), "Bitfield IDs must be unique");
+
+    //! Positions of the first bits of the bitfields, counted from the most significant bit of the register.
+    static constexpr std::array<std::size_t, sizeof...(Bitfields)> compute_starts()
+    {
+        std::array<std::size_t, sizeof...(Bitfields)> result{};
+        for (std::size_t i{1}; i < sizes.size(); ++i)
+            result[i] = result[i - 1] + sizes[i - 1];
+        return result;
+    }
+
+    static inline constexpr auto starts{compute_starts()};
+
+    template<auto Id>
+    static inline constexpr std::size_t find_index()
+    {
+        constexpr auto index{detail::lookup(id_index, Id)};
+        static_assert(index != sizeof...(Bitfields), "Bitfield ID not found");
+        return index;
+    }
+
+    static constexpr Value low_mask(std::size_t bits)
+    {
+        return bits >= 64 ? ~Value{0} : (Value{1} << bits) - 1;
+    }
+
+    /**
+     * The register is accessed through windows: the words of the array, or, for byte arrays, 64-bit slices starting
+     * at any byte. The whole array is a single window, if it has less than 8 bytes.
+     */
+    using Window = std::conditional_t<is_byte_array, Value, Word>;
+
+    static inline constexpr std::size_t window_bits{is_byte_array ? (N < 8 ? N * 8 : 64) : word_bits};
+
+    //! Part of a bitfield, [first_bit, last_bit), accessed through the window.
+    struct segment
+    {
+        std::size_t window;
+        std::size_t first_bit;
+        std::size_t last_bit;
+    };
+
+    static constexpr std::size_t window_start(std::size_t window)
+    {
+        return is_byte_array ? window * 8 : window * word_bits;
+    }
+
+    template<auto Id>
+    static constexpr std::size_t count_segments()
+    {
+        constexpr auto first{starts[find_index<Id>()]};
+        constexpr auto last{first + sizes[find_index<Id>()]};
+        if constexpr (!is_byte_array)
+            return (last - 1) / word_bits - first / word_bits + 1;
+        else if constexpr (N < 8)
+            return 1;
+        else
+            return last <= window_start(first_byte_window(first)) + 64 ? 1 : 2;
+    }
+
+    static constexpr std::size_t first_byte_window(std::size_t first_bit)
+    {
+        return first_bit / 8 < N - 8 ? first_bit / 8 : N - 8;
+    }
+
+    template<auto Id>
+    static constexpr std::array<segment, count_segments<Id>()> compute_segments()
+    {
+        constexpr auto first{starts[find_index<Id>()]};
+        constexpr auto last{first + sizes[find_index<Id>()]};
+        std::array<segment, count_segments<Id>()> result{};
+        if constexpr (!is_byte_array)
+        {
+            for (std::size_t i{0}; i < result.size(); ++i)
+            {
+                auto window{first / word_bits + i};
+                auto window_first{window_start(window)};
+                auto window_last{window_first + word_bits};
+                result[i] = {window, first > window_first ? first : window_first, last < window_last ? last : window_last};
+            }
+        } else if constexpr (N < 8)
+        {
+            result[0] = {0, first, last};
+        } else
+        {
+            auto window{first_byte_window(first)};
+            auto window_last{window_start(window) + 64};
+            result[0] = {window, first, last < window_last ? last : window_last};
+            if constexpr (result.size() == 2)
+                result[1] = {(last + 7) / 8 - 8, window_last, last};
+        }
+        return result;
+    }
+
+    // Variable templates force the compile-time evaluation also when used within fold expressions.
+    template<auto Id>
+    static inline constexpr auto segments{compute_segments<Id>()};
+
+    template<auto Id>
+    static inline constexpr Value bitfield_mask{low_mask(sizes[find_index<Id>()])};
+
+    template<std::size_t W>
+    constexpr Window load_window() const
+    {
+        if constexpr (!is_byte_array)
+        {
+            return storage[W];
+        } else if constexpr (N < 8)
+        {
+            Value result{0};
+            for (auto byte : storage)
+                result = (result << 8) | static_cast<uint8_t>(byte);
+            return result;
+        } else
+        {
+            return detail::load<byte_order::big, Value>(reinterpret_cast<const uint8_t*>(storage.data()) + W);
+        }
+    }
+
+    template<std::size_t W>
+    constexpr void store_window(Window window)
+    {
+        if constexpr (!is_byte_array)
+        {
+            storage[W] = window;
+        } else if constexpr (N < 8)
+        {
+            for (std::size_t i{N}; i > 0; --i, window >>= 8)
+                storage[i - 1] = static_cast<Word>(window & 0xFF);
+        } else
+        {
+            detail::store<byte_order::big>(window, reinterpret_cast<uint8_t*>(storage.data()) + W);
+        }
+    }
+
+    template<auto Id, std::size_t I>
+    constexpr Value extract() const
+    {
+        constexpr auto s{segments<Id>[I]};
+        constexpr auto shift{window_start(s.window) + window_bits - s.last_bit};
+        return (static_cast<Value>(load_window<s.window>()) >> shift) & low_mask(s.last_bit - s.first_bit);
+    }
+
+    template<auto Id, std::size_t... I>
+    constexpr Value extract(std::index_sequence<I...>) const
+    {
+        Value result{0};
+        ((result = append(result, extract<Id, I>(), segments<Id>[I].last_bit - segments<Id>[I].first_bit)), ...);
+        return result;
+    }
+
+    static constexpr Value append(Value result, Value part, std::size_t part_bits)
+    {
+        return part_bits >= 64 ? part : (result << part_bits) | part;
+    }
+
+    /**
+     * Applies the operation to each window the bitfield spans, with the part of the bitfield mask and of the value
+     * shifted to the position of the bitfield within the window: operation(window, mask, value) -> window.
+     */
+    template<auto Id, std::size_t I, typename Operation>
+    constexpr void modify(Value value, Operation operation)
+    {
+        constexpr auto s{segments<Id>[I]};
+        constexpr auto shift{window_start(s.window) + window_bits - s.last_bit};
+        constexpr auto field_last{starts[find_index<Id>()] + sizes[find_index<Id>()]};
+        constexpr auto mask{low_mask(s.last_bit - s.first_bit)};
+
+        auto part{(value >> (field_last - s.last_bit)) & mask};
+        auto window{static_cast<Value>(load_window<s.window>())};
+        store_window<s.window>(static_cast<Window>(operation(window, mask << shift, part << shift)));
+    }
+
+    template<auto Id, typename Operation, std::size_t... I>
+    constexpr void modify(Value value, Operation operation, std::index_sequence<I...>)
+    {
+        (modify<Id, I>(value, operation), ...);
+    }
+
+    template<auto Id, typename Operation>
+    constexpr void modify(Value value, Operation operation)
+    {
+        modify<Id>(value, operation, std::make_index_sequence<segments<Id>.size()>{});
+    }
+
+    static constexpr Value or_bits(Value window, Value, Value bits)
+    {
+        return window | bits;
+    }
+
+    static constexpr Value clear_bits(Value window, Value, Value bits)
+    {
+        return window & ~bits;
+    }
+
+    static constexpr Value replace_bits(Value window, Value mask, Value bits)
+    {
+        return (window & ~mask) | bits;
+    }
+
+  public:
+    //! Policy used to handle the values that don't fit the bitfields.
+    using overflow_policy = OverflowPolicy;
+
+    //! The same register with a different jungles::overflow policy.
+    template<typename Policy>
+    using with_policy = basic_wide_register<Policy, Storage, Bitfields...>;
+
+    //! Type of the array backing the register.
+    using storage_type = Storage;
+
+    //! Type of the values of the bitfields.
+    using value_type = Value;
+
+    //! The jungles::bitfield descriptors in the order of declaration.
+    using bitfields = std::tuple<Bitfields...>;
+
+    //! Number of bitfields the register is composed of.
+    static inline constexpr std::size_t bitfield_count{sizeof...(Bitfields)};
+
+    //! Returns the non-shifted mask of the bitfield, which is also the maximum value the bitfield can store.
+    template<auto Id>
+    static inline constexpr Value mask()
+    {
+        return bitfield_mask<Id>;
+    }
+
+    //! Constructs the register from the array, the most significant word first. Zeroed if not specified.
+    constexpr basic_wide_register(const Storage& initial_value = Storage{}) : storage{initial_value}
+    {
+    }
+
+    //! Returns the value of the specified bitfield.
+    template<auto Id>
+    constexpr Value get() const
+    {
+        return extract<Id>(std::make_index_sequence<segments<Id>.size()>{});
+    }
+
+    //! Sets all the bits of the bitfield.
+    template<auto Id>
+    constexpr Self& set()
+    {
+        modify<Id>(bitfield_mask<Id>, or_bits);
+        return *this;
+    }
+
+    //! Sets the bitfield to the value, that is equivalent to "|= value" operation on the bitfield.
+    template<auto Id>
+    constexpr decltype(auto) set(Value value)
+    {
+        return OverflowPolicy::template run<overflow_error>(is_overflowing<Id>(value), *this, [&]() {
+            modify<Id>(OverflowPolicy::adjust(value, bitfield_mask<Id>), or_bits);
+        });
+    }
+
+    //! Assigns the value to the bitfield, leaving the other bitfields unchanged.
+    template<auto Id>
+    constexpr decltype(auto) assign(Value value)
+    {
+        return OverflowPolicy::template run<overflow_error>(is_overflowing<Id>(value), *this, [&]() {
+            modify<Id>(OverflowPolicy::adjust(value, bitfield_mask<Id>), replace_bits);
+        });
+    }
+
+    //! Clears all the bits of the bitfield.
+    template<auto Id>
+    constexpr Self& clear()
+    {
+        modify<Id>(bitfield_mask<Id>, clear_bits);
+        return *this;
+    }
+
+    //! Clears the bitfield applying the mask. That is equivalent to "&= ~(mask)" operation on the bitfield.
+    template<auto Id>
+    constexpr decltype(auto) clear(Value mask)
+    {
+        return OverflowPolicy::template run<mask_not_matching_error>(is_overflowing<Id>(mask), *this, [&]() {
+            modify<Id>(OverflowPolicy::adjust(mask, bitfield_mask<Id>), clear_bits);
+        });
+    }
+
+    //! Returns the array backing the register.
+    constexpr const Storage& operator()() const
+    {
+        return storage;
+    }
+
+    struct mask_not_matching_error : std::exception
+    {
+        //! Returned instead of throwing under jungles::overflow::return_error policy.
+        static inline constexpr std::errc code{std::errc::invalid_argument};
+    };
+
+    struct overflow_error : std::exception
+    {
+        //! Returned instead of throwing under jungles::overflow::return_error policy.
+        static inline constexpr std::errc code{std::errc::value_too_large};
+    };
+
+  private:
+    template<auto Id>
+    static constexpr bool is_overflowing(Value value)
+    {
+        return (value & ~bitfield_mask<Id>) != 0;
+    }
+
+    Storage storage;
+};
+
+//! Wide register which throws when a value doesn't fit the bitfield. See jungles::basic_wide_register.
+template<typename Storage, typename... Bitfields>
+using wide_register = basic_wide_register<overflow::throw_error, Storage, Bitfields...>;
+
+} // namespace jungles
+
+#endif /* WIDE_REGISTER_HPP */
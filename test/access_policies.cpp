@@ -0,0 +1,297 @@
+/**
+ * @file	access_policies.cpp
+ * @brief	Tests the read-only, write-only and write-1-to-clear bitfields, and the reset values of the map elements.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/deferred.hpp"
+#include "small_register/memory_transport.hpp"
+#include "small_register/mmio_register.hpp"
+#include "small_register/register_file.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+struct recording_bus
+{
+    void write(int address, unsigned value)
+    {
+        writes.emplace_back(address, value);
+    }
+
+    unsigned read(int address)
+    {
+        reads.push_back(address);
+        return 0xFF;
+    }
+
+    std::vector<std::pair<int, unsigned>> writes;
+    std::vector<int> reads;
+};
+
+// Interrupt status: a read-only state, two write-1-to-clear flags and a read-write enable.
+using Status = small_register<uint8_t,
+                              bitfield<reg::four, 4>,
+                              write_1_to_clear<bitfield<reg::three, 1>>,
+                              write_1_to_clear<bitfield<reg::two, 1>>,
+                              read_only<bitfield<reg::one, 2>>>;
+
+// Interrupt flags only: no read-write bit to preserve.
+using Flags = small_register<uint8_t,
+                             write_1_to_clear<bitfield<reg::three, 3>>,
+                             write_1_to_clear<bitfield<reg::two, 1>>,
+                             read_only<bitfield<reg::one, 4>>>;
+
+// Command register: nothing can be read back.
+using Command = small_register<uint8_t, write_only<bitfield<reg::two, 5>>, write_only<bitfield<reg::one, 3>>>;
+
+// Control with a write-only trigger.
+using Control = small_register<uint8_t, write_only<bitfield<reg::two, 1>>, bitfield<reg::one, 7>>;
+
+} // namespace
+
+TEST_CASE("Access masks are computed from the bitfields", "[access_policies]")
+{
+    STATIC_REQUIRE(Status::access_mask<field_access::read_only> == 0b0000'0011);
+    STATIC_REQUIRE(Status::access_mask<field_access::write_1_to_clear> == 0b0000'1100);
+    STATIC_REQUIRE(Status::access_mask<field_access::read_write> == 0b1111'0000);
+    STATIC_REQUIRE(Status::access_mask<field_access::write_only> == 0);
+    STATIC_REQUIRE(Command::access_mask<field_access::write_only> == 0xFF);
+    STATIC_REQUIRE(Status::bitfield_type<reg::two>::access == field_access::write_1_to_clear);
+}
+
+TEST_CASE("Written values clear only the cleared write-1-to-clear bits", "[access_policies]")
+{
+    SECTION("The flags pending and not cleared are written as zeros")
+    {
+        REQUIRE(Status::written_value(0b1010'1111, 0b0101'1111) == 0b0101'0011);
+    }
+
+    SECTION("The cleared flags are written as ones")
+    {
+        REQUIRE(Status::written_value(0b1010'1111, 0b1010'0111) == 0b1010'1011);
+        REQUIRE(Status::written_value(0b1010'1111, 0b1010'0011) == 0b1010'1111);
+    }
+
+    SECTION("The flags which weren't pending aren't written")
+    {
+        REQUIRE(Status::written_value(0b0000'0000, 0b0000'0000) == 0);
+    }
+}
+
+TEST_CASE("Write-1-to-clear bitfields can be cleared", "[access_policies]")
+{
+    Status r{0b0000'1111};
+    r.clear<reg::two>();
+    REQUIRE(r() == 0b0000'1011);
+    REQUIRE(r.get<reg::one>() == 0b11);
+}
+
+TEST_CASE("Memory-mapped registers respect the access of the bitfields", "[access_policies]")
+{
+    volatile uint8_t memory{0b0110'1110};
+    counting_access::reset();
+
+    SECTION("Registers with read-write bitfields are loaded and only the cleared flags are written as ones")
+    {
+        mmio_register<Status, counting_access> r{&memory};
+        r.modify([](auto& reg) { reg.template clear<reg::three>().template assign<reg::four>(0x9); });
+
+        REQUIRE(counting_access::loads == 1);
+        REQUIRE(counting_access::stores == 1);
+        REQUIRE(counting_access::stored == 0b1001'1010);
+    }
+
+    SECTION("Registers with no read-write bitfields are cleared without any load")
+    {
+        mmio_register<Flags, counting_access> r{&memory};
+        r.clear<reg::three>(0b010);
+
+        REQUIRE(counting_access::loads == 0);
+        REQUIRE(counting_access::stores == 1);
+        REQUIRE(counting_access::stored == 0b0100'0000);
+    }
+
+    SECTION("Write-only registers are written without any load")
+    {
+        mmio_register<Command, counting_access> r{&memory};
+        r.modify([](auto& reg) { reg.template assign<reg::one, reg::two>(0b101, 0b10001); });
+
+        REQUIRE(counting_access::loads == 0);
+        REQUIRE(counting_access::stored == 0b1000'1101);
+    }
+
+    SECTION("Write-only bitfields read back as ones are written as zeros")
+    {
+        memory = 0x80;
+        mmio_register<Control, counting_access> r{&memory};
+        r.assign<reg::one>(5);
+
+        REQUIRE(counting_access::loads == 1);
+        REQUIRE(counting_access::stored == 0x05);
+    }
+
+    SECTION("Readable bitfields of registers with write-only bitfields are read")
+    {
+        mmio_register<Control, counting_access> r{&memory};
+        REQUIRE(r.get<reg::one>() == 0b110'1110);
+    }
+}
+
+TEST_CASE("Deferred chains respect the access of the bitfields", "[access_policies]")
+{
+    volatile uint8_t memory{0b0110'1110};
+    counting_access::reset();
+
+    SECTION("The flags are cleared with a single store, without any load")
+    {
+        mmio_register<Flags, counting_access> r{&memory};
+        defer(r).clear<reg::two>().clear<reg::three>(0b100);
+
+        REQUIRE(counting_access::loads == 0);
+        REQUIRE(counting_access::stores == 1);
+        REQUIRE(counting_access::stored == 0b1001'0000);
+    }
+
+    SECTION("The pending flags are written as zeros when the read-write bitfields are preserved")
+    {
+        mmio_register<Status, counting_access> r{&memory};
+        defer(r).clear<reg::two>();
+
+        REQUIRE(counting_access::loads == 1);
+        REQUIRE(counting_access::stores == 1);
+        REQUIRE(counting_access::stored == 0b0110'0110);
+    }
+
+    SECTION("Write-only bitfields read back as ones are written as zeros")
+    {
+        memory = 0x81;
+        mmio_register<Control, counting_access> r{&memory};
+        defer(r).set<reg::one>(0b100);
+
+        REQUIRE(counting_access::loads == 1);
+        REQUIRE(counting_access::stored == 0x05);
+    }
+}
+
+TEST_CASE("Map elements have reset values", "[access_policies]")
+{
+    using Map = small_map<element<0x00, Control, 0x40>, element<0x01, Command, 0x05>, element<0x02, Flags>>;
+
+    STATIC_REQUIRE(Map::reset_value<0x00>()() == 0x40);
+    STATIC_REQUIRE(Map::reset_value<0x01>()() == 0x05);
+    STATIC_REQUIRE(Map::reset_value<0x02>()() == 0x00);
+
+    memory_transport<3> transport;
+    transport.memory = {0x12, 0xAA, 0b1111'0110};
+
+    SECTION("Write-only registers are modified without any read, starting from the reset value")
+    {
+        Map::modify<0x01>(transport, [](auto& reg) { reg.template assign<reg::two>(0b11); });
+
+        REQUIRE(transport.reads == 0);
+        REQUIRE(transport.writes == 1);
+        REQUIRE(transport.memory[1] == 0b0001'1101);
+    }
+
+    SECTION("Registers with no read-write bitfields are modified without any read, clearing only the cleared flags")
+    {
+        Map::modify<0x02>(transport, [](auto& reg) { reg.template clear<reg::two>(); });
+
+        REQUIRE(transport.reads == 0);
+        REQUIRE(transport.memory[2] == 0b0001'0000);
+    }
+
+    SECTION("Other registers are read, modified and written")
+    {
+        Map::modify<0x00>(transport, Control{}, [](auto& reg) { reg.template set<reg::one>(0x01); });
+
+        REQUIRE(transport.reads == 1);
+        REQUIRE(transport.writes == 1);
+        REQUIRE(transport.memory[0] == 0x13);
+    }
+
+    SECTION("Write-only bitfields are written with the values passed, whatever is read back")
+    {
+        transport.memory[0] = 0x80;
+        Map::modify<0x00>(transport, Control{0x00}, [](auto& reg) { reg.template assign<reg::one>(5); });
+        REQUIRE(transport.memory[0] == 0x05);
+
+        transport.memory[0] = 0x00;
+        Map::modify<0x00>(transport, Control{0xFF}, [](auto& reg) { reg.template assign<reg::one>(5); });
+        REQUIRE(transport.memory[0] == 0x85);
+    }
+
+    SECTION("Nothing is written when the function fails")
+    {
+        using Checked =
+            basic_small_register<overflow::return_error, uint8_t, bitfield<reg::one, 4>, bitfield<reg::two, 4>>;
+        using CheckedMap = small_map<element<0x00, Checked>>;
+
+        auto result{CheckedMap::modify<0x00>(transport, [](auto& reg) { return reg.template set<reg::one>(0x10); })};
+
+        REQUIRE(result == std::errc::value_too_large);
+        REQUIRE(transport.writes == 0);
+    }
+}
+
+TEST_CASE("Register files respect the access of the bitfields and the reset values", "[access_policies]")
+{
+    using Map = small_map<element<0x00, Control, 0x40>, element<0x01, Command, 0x05>, element<0x02, Status, 0x30>>;
+    register_file<Map> registers;
+    recording_bus bus;
+
+    SECTION("The registers are constructed with the reset values")
+    {
+        REQUIRE(registers.get<0x00>()() == 0x40);
+        REQUIRE(registers.get<0x01>()() == 0x05);
+        REQUIRE(registers.get<0x02>()() == 0x30);
+        REQUIRE_FALSE(registers.is_dirty());
+    }
+
+    SECTION("Reset discards the modifications")
+    {
+        registers.store<0x00>(Control{0x01});
+        registers.reset();
+
+        REQUIRE(registers.get<0x00>()() == 0x40);
+        REQUIRE_FALSE(registers.is_dirty());
+    }
+
+    SECTION("Fetch skips the write-only registers and keeps the write-only bitfields")
+    {
+        registers.store<0x00>(Control{0x00});
+        registers.fetch(bus);
+
+        REQUIRE(bus.reads == std::vector<int>{0x00, 0x02});
+        REQUIRE(registers.get<0x00>()() == 0x7F);
+        REQUIRE(registers.get<0x01>()() == 0x05);
+        REQUIRE(registers.get<0x02>()() == 0xFF);
+    }
+
+    SECTION("Flush writes ones only to the flags cleared since the fetch")
+    {
+        registers.fetch(bus);
+        auto status{registers.get<0x02>()};
+        registers.store<0x02>(status.clear<reg::three>());
+
+        REQUIRE(registers.flush(bus) == 1);
+        REQUIRE(bus.writes == std::vector<std::pair<int, unsigned>>{{0x02, 0b1111'1011}});
+
+        registers.store<0x02>(status.assign<reg::four>(0x1));
+        registers.flush(bus);
+
+        REQUIRE(bus.writes.back() == std::pair<int, unsigned>{0x02, 0b0001'0011});
+    }
+}
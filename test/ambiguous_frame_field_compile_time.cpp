@@ -0,0 +1,22 @@
+/**
+ * @file	ambiguous_frame_field_compile_time.cpp
+ * @brief	Test for static assertion is triggered when a bitfield ID is found in more than one register of a frame.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/frame.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+void ambiguous_frame_field_compile_time()
+{
+    using Reg1 = small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 6>>;
+    using Reg2 = small_register<uint8_t, bitfield<reg::three, 4>, bitfield<reg::one, 4>>;
+
+    uint8_t buffer[2]{};
+    frame<Reg1, Reg2>::make_view(buffer).get<reg::one>();
+}
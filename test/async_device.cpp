@@ -0,0 +1,181 @@
+/**
+ * @file	async_device.cpp
+ * @brief	Tests reading and writing the registers with coroutines, over the simulated bus.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/async_device.hpp"
+
+#include "helpers.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace jungles;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Reg8 = small_register<uint8_t, bitfield<reg::one, 3>, bitfield<reg::two, 5>>;
+using Reg16 = small_register<uint16_t, bitfield<reg::three, 4>, bitfield<reg::four, 12>>;
+using Command = small_register<uint8_t, write_only<bitfield<reg::five, 8>>>;
+
+using Map = small_map<element<0x00, Reg8>, element<0x01, Reg16>, element<0x03, Command>>;
+using Bus = simulated_bus<4>;
+using Device = async_device<Map, Bus>;
+
+task<int> answer()
+{
+    co_return 42;
+}
+
+task<int> add_to_answer(int value)
+{
+    co_return co_await answer() + value;
+}
+
+task<void> fail()
+{
+    throw std::runtime_error{"Task failed"};
+    co_return;
+}
+
+task<uint16_t> increment(Device& device)
+{
+    auto r{co_await device.read<0x01>()};
+    r.assign<reg::four>(r.get<reg::four>() + 1);
+    co_await device.write(r);
+    co_return r.get<reg::four>();
+}
+
+task<void> read_and_record(Device& device, std::vector<int>& order, int id)
+{
+    co_await device.read<0x00>();
+    order.push_back(id);
+}
+
+task<uint16_t> increment_and_record(Device& device, std::vector<int>& completions, int id)
+{
+    auto r{co_await device.read<0x01>()};
+    completions.push_back(id);
+    r.assign<reg::four>(r.get<reg::four>() + 1);
+    co_await device.write(r);
+    completions.push_back(id);
+    co_return r.get<reg::four>();
+}
+
+} // namespace
+
+TEST_CASE("Tasks produce results and propagate exceptions", "[async_device]")
+{
+    run_loop loop;
+
+    REQUIRE(loop.run(add_to_answer(8)) == 50);
+    REQUIRE_THROWS_AS(loop.run(fail()), std::runtime_error);
+}
+
+TEST_CASE("Tasks started on the executor are run to completion", "[async_device]")
+{
+    run_loop loop;
+    auto work{answer()};
+    work.start(loop);
+
+    REQUIRE_FALSE(work.is_ready());
+    loop.run();
+    REQUIRE(work.is_ready());
+    REQUIRE(work.result() == 42);
+}
+
+TEST_CASE("Registers are read and written with coroutines", "[async_device]")
+{
+    run_loop loop;
+    Bus bus{loop, 0us};
+    Device device{bus};
+    bus.memory = {0b1010'1010, 0x12, 0x34, 0x00};
+
+    SECTION("Read registers are produced, the most significant byte first")
+    {
+        auto read{[&]() -> task<uint16_t> {
+            auto r8{co_await device.read<0x00>()};
+            auto r16{co_await device.read<0x01>()};
+            co_return static_cast<uint16_t>(r8.get<reg::one>() + r16.get<reg::four>());
+        }};
+
+        REQUIRE(loop.run(read()) == 0b101 + 0x234);
+        REQUIRE(bus.reads == 2);
+    }
+
+    SECTION("Written registers are stored under their addresses")
+    {
+        REQUIRE(loop.run(increment(device)) == 0x235);
+        REQUIRE(bus.memory[1] == 0x12);
+        REQUIRE(bus.memory[2] == 0x35);
+        REQUIRE(bus.writes == 1);
+    }
+
+    SECTION("Registers are written under an explicit address")
+    {
+        auto write{[&]() -> task<void> { co_await device.write<0x03>(Command{0x5A}); }};
+
+        loop.run(write());
+        REQUIRE(bus.memory[3] == 0x5A);
+    }
+
+    SECTION("Errors of the transport are thrown from co_await")
+    {
+        using Wider = small_map<element<0x03, Reg16>>;
+        async_device<Wider, Bus> wider{bus};
+        auto read{[&]() -> task<void> { co_await wider.read<0x03>(); }};
+
+        REQUIRE_THROWS_AS(loop.run(read()), std::out_of_range);
+    }
+}
+
+TEST_CASE("Transactions with many devices are in flight at once", "[async_device]")
+{
+    run_loop loop;
+    const auto latency{2ms};
+    std::vector<Bus> buses(8, Bus{loop, latency});
+    std::vector<Device> devices;
+    for (auto& bus : buses)
+        devices.emplace_back(bus);
+
+    std::vector<task<uint16_t>> tasks;
+    std::vector<int> completions;
+    auto start{run_loop::clock::now()};
+    for (int id{0}; id < static_cast<int>(devices.size()); ++id)
+    {
+        tasks.push_back(increment_and_record(devices[id], completions, id));
+        tasks.back().start(loop);
+    }
+    loop.run();
+
+    for (auto& work : tasks)
+        REQUIRE(work.result() == 1);
+    // All the reads complete before any write; performed one after another, each read would be followed by its write.
+    REQUIRE(completions == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7});
+    REQUIRE(run_loop::clock::now() - start >= 2 * latency);
+}
+
+TEST_CASE("Transactions with a single device are performed in order", "[async_device]")
+{
+    run_loop loop;
+    Bus bus{loop, 1ms};
+    Device device{bus};
+    std::vector<int> order;
+
+    std::vector<task<void>> tasks;
+    for (int id{0}; id < 4; ++id)
+    {
+        tasks.push_back(read_and_record(device, order, id));
+        tasks.back().start(loop);
+    }
+    auto start{run_loop::clock::now()};
+    loop.run();
+
+    REQUIRE(order == std::vector<int>{0, 1, 2, 3});
+    REQUIRE(run_loop::clock::now() - start >= 4ms);
+}
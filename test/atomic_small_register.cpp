@@ -0,0 +1,149 @@
+/**
+ * @file	atomic_small_register.cpp
+ * @brief	Tests the lock-free register, also when modified concurrently by multiple threads.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/atomic_small_register.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Status = small_register<uint32_t,
+                              bitfield<reg::one, 1>,
+                              bitfield<reg::two, 1>,
+                              bitfield<reg::three, 1>,
+                              bitfield<reg::four, 1>,
+                              bitfield<reg::five, 4>,
+                              bitfield<reg::six, 8>,
+                              bitfield<reg::seven, 8>,
+                              bitfield<reg::eight, 8>>;
+
+template<typename Function>
+void run_concurrently(unsigned thread_count, Function function)
+{
+    std::vector<std::thread> threads;
+    for (unsigned i{0}; i < thread_count; ++i)
+        threads.emplace_back(function, i);
+    for (auto& t : threads)
+        t.join();
+}
+
+} // namespace
+
+TEST_CASE("Atomic register is modified as the small_register", "[atomic_small_register]")
+{
+    atomic_small_register<Status> status{Status{0x0F000000}};
+
+    SECTION("Set and clear return the previous value")
+    {
+        REQUIRE(status.set<reg::one>()() == 0x0F000000);
+        REQUIRE(status.clear<reg::five>(std::memory_order_release)() == 0x8F000000);
+        REQUIRE(status.load()() == 0x80000000);
+    }
+
+    SECTION("Runtime values are checked according to the policy")
+    {
+        status.set<reg::six, reg::eight>(0x12, 0x34);
+        status.assign<reg::five>(0b1010, std::memory_order_relaxed);
+        status.clear<reg::six>(0x02);
+
+        REQUIRE(status.get<reg::five, reg::six, reg::eight>() == std::tuple{0b1010u, 0x10u, 0x34u});
+        REQUIRE_THROWS_AS(status.assign<reg::six>(0x100), Status::overflow_error);
+
+        atomic_small_register<Status::with_policy<overflow::return_error>> checked;
+        REQUIRE(checked.set<reg::five>(0x10) == std::errc::value_too_large);
+        REQUIRE(checked.load()() == 0);
+    }
+
+    SECTION("Compile-time values are assigned")
+    {
+        status.assign<reg::five, 0b0101>();
+        REQUIRE(status.get<reg::five>() == 0b0101);
+    }
+}
+
+TEST_CASE("Atomic register is modified concurrently", "[atomic_small_register][stress]")
+{
+    constexpr unsigned iterations{20000};
+    atomic_small_register<Status> status;
+
+    SECTION("Flags owned by the threads are set and cleared without losing updates")
+    {
+        std::atomic<unsigned> mismatches{0};
+        run_concurrently(4, [&](unsigned thread) {
+            for (unsigned i{0}; i < iterations; ++i)
+            {
+                bool is_set{false};
+                switch (thread)
+                {
+                case 0:
+                    status.set<reg::one>();
+                    is_set = status.get<reg::one>() == 1;
+                    status.clear<reg::one>();
+                    break;
+                case 1:
+                    status.set<reg::two>();
+                    is_set = status.get<reg::two>() == 1;
+                    status.clear<reg::two>();
+                    break;
+                case 2:
+                    status.set<reg::three>();
+                    is_set = status.get<reg::three>() == 1;
+                    status.clear<reg::three>();
+                    break;
+                default:
+                    status.set<reg::four>();
+                    is_set = status.get<reg::four>() == 1;
+                    status.clear<reg::four>();
+                    break;
+                }
+                if (!is_set)
+                    ++mismatches;
+            }
+        });
+
+        REQUIRE(mismatches == 0);
+        REQUIRE(status.load()() == 0);
+    }
+
+    SECTION("Fields owned by the threads are assigned without losing updates")
+    {
+        run_concurrently(3, [&](unsigned thread) {
+            for (unsigned i{1}; i <= iterations; ++i)
+            {
+                auto value{static_cast<uint32_t>(i & 0xFF)};
+                if (thread == 0)
+                    status.assign<reg::six>(value, std::memory_order_acq_rel);
+                else if (thread == 1)
+                    status.assign<reg::seven>(value, std::memory_order_acq_rel);
+                else
+                    status.assign<reg::eight>(value, std::memory_order_acq_rel);
+            }
+        });
+
+        constexpr auto last{iterations & 0xFF};
+        REQUIRE(status.get<reg::six, reg::seven, reg::eight>() == std::tuple{last, last, last});
+    }
+
+    SECTION("Shared counter is incremented without losing updates")
+    {
+        run_concurrently(4, [&](unsigned) {
+            for (unsigned i{0}; i < iterations; ++i)
+                status.modify([](auto& r) { r.template assign<reg::six>((r.template get<reg::six>() + 1) & 0xFF); });
+        });
+
+        REQUIRE(status.get<reg::six>() == (4 * iterations) % 256);
+    }
+}
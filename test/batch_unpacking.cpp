@@ -0,0 +1,142 @@
+/**
+ * @file	batch_unpacking.cpp
+ * @brief	Tests extraction and conversion of bitfields from arrays of raw register values.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_template_test_macros.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register_batch.hpp"
+
+#include "helpers.hpp"
+
+#include <ratio>
+#include <vector>
+
+using namespace jungles;
+
+template<typename Register>
+static std::vector<typename Register::underlying_type> make_samples(std::size_t count)
+{
+    using T = typename Register::underlying_type;
+    std::vector<T> samples(count);
+    uint64_t state{0x9E3779B97F4A7C15ull};
+    for (auto& s : samples)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        s = static_cast<T>(state);
+    }
+    return samples;
+}
+
+template<typename T, unsigned Size3, unsigned Size4, unsigned Size5>
+using FiveBitfields = small_register<T,
+                                     bitfield<reg::one, 1>,
+                                     bitfield<reg::two, 3>,
+                                     bitfield<reg::three, Size3>,
+                                     bitfield<reg::four, Size4>,
+                                     bitfield<reg::five, Size5>>;
+
+TEMPLATE_TEST_CASE("Bitfields are unpacked from arrays of raw registers",
+                   "[small_register][batch]",
+                   (FiveBitfields<uint8_t, 1, 2, 1>),
+                   (FiveBitfields<uint16_t, 5, 3, 4>),
+                   (FiveBitfields<uint32_t, 13, 3, 12>),
+                   (FiveBitfields<uint64_t, 28, 3, 29>))
+{
+    using Register = TestType;
+    using T = typename Register::underlying_type;
+
+    // Not a multiple of any vector width, so that the scalar tail is exercised as well.
+    auto samples{make_samples<Register>(2 * 1024 + 37)};
+    const auto count{samples.size()};
+
+    SECTION("Single bitfield matches get()")
+    {
+        std::vector<T> out(count);
+        unpack<Register, reg::three>(samples.data(), samples.data() + count, out.data());
+
+        for (std::size_t i{0}; i < count; ++i)
+            REQUIRE(out[i] == Register{samples[i]}.template get<reg::three>());
+    }
+
+    SECTION("Bitfield at the most significant position matches get()")
+    {
+        std::vector<T> out(count);
+        unpack<Register, reg::one>(samples.data(), samples.data() + count, out.data());
+
+        for (std::size_t i{0}; i < count; ++i)
+            REQUIRE(out[i] == Register{samples[i]}.template get<reg::one>());
+    }
+
+    SECTION("All bitfields match get()")
+    {
+        std::vector<T> one(count), two(count), three(count), four(count), five(count);
+        unpack_all<Register>(
+            samples.data(), samples.data() + count, {one.data(), two.data(), three.data(), four.data(), five.data()});
+
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            Register r{samples[i]};
+            REQUIRE(one[i] == r.template get<reg::one>());
+            REQUIRE(two[i] == r.template get<reg::two>());
+            REQUIRE(three[i] == r.template get<reg::three>());
+            REQUIRE(four[i] == r.template get<reg::four>());
+            REQUIRE(five[i] == r.template get<reg::five>());
+        }
+    }
+
+    SECTION("Empty range is handled")
+    {
+        T out{0x5A};
+        unpack<Register, reg::two>(samples.data(), samples.data(), &out);
+        REQUIRE(out == 0x5A);
+    }
+}
+
+template<typename T, unsigned Size3, unsigned Size4, unsigned Size5>
+using ScaledFields = small_register<T,
+                                    bitfield<reg::one, 1>,
+                                    bitfield<reg::two, 3>,
+                                    signed_bitfield<reg::three, Size3, std::ratio<1, 16>>,
+                                    scaled_bitfield<reg::four, Size4, std::ratio<5>, std::ratio<-7>>,
+                                    signed_bitfield<reg::five, Size5>>;
+
+TEMPLATE_TEST_CASE("Bitfields are converted from arrays of raw registers",
+                   "[small_register][batch]",
+                   (ScaledFields<uint8_t, 1, 2, 1>),
+                   (ScaledFields<uint16_t, 5, 3, 4>),
+                   (ScaledFields<uint32_t, 13, 3, 12>),
+                   (ScaledFields<uint64_t, 28, 3, 29>))
+{
+    using Register = TestType;
+
+    auto samples{make_samples<Register>(2 * 1024 + 37)};
+    const auto count{samples.size()};
+
+    SECTION("Conversion to float matches get_as()")
+    {
+        std::vector<float> three(count), four(count), five(count);
+        convert<Register, reg::three>(samples.data(), samples.data() + count, three.data());
+        convert<Register, reg::four>(samples.data(), samples.data() + count, four.data());
+        convert<Register, reg::five>(samples.data(), samples.data() + count, five.data());
+
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            Register r{samples[i]};
+            REQUIRE(three[i] == r.template get_as<reg::three, float>());
+            REQUIRE(four[i] == r.template get_as<reg::four, float>());
+            REQUIRE(five[i] == r.template get_as<reg::five, float>());
+        }
+    }
+
+    SECTION("Conversion to int matches get_as()")
+    {
+        std::vector<int> five(count);
+        convert<Register, reg::five>(samples.data(), samples.data() + count, five.data());
+
+        for (std::size_t i{0}; i < count; ++i)
+            REQUIRE(five[i] == Register{samples[i]}.template get_as<reg::five, int>());
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file	bitfield_array.cpp
+ * @brief	Tests accessing the elements of bitfield arrays with indices known at runtime.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <array>
+#include <cstdint>
+#include <system_error>
+
+using namespace jungles;
+
+namespace
+{
+
+// The pins 0-5 of a GPIO expander, 2 bits of the mode each, between a 3-bit and a 1-bit bitfield.
+using Gpio = small_register<uint16_t, bitfield<reg::one, 3>, bitfield_array<reg::two, 2, 6>, bitfield<reg::three, 1>>;
+
+} // namespace
+
+TEST_CASE("Elements of bitfield arrays are accessed by index", "[bitfield_array]")
+{
+    Gpio r{0b101'10'01'00'11'10'01'1};
+
+    SECTION("Elements are read starting from the least significant one")
+    {
+        REQUIRE(r.get<reg::two>(0) == 0b01);
+        REQUIRE(r.get<reg::two>(1) == 0b10);
+        REQUIRE(r.get<reg::two>(2) == 0b11);
+        REQUIRE(r.get<reg::two>(5) == 0b10);
+        REQUIRE(r.elements<reg::two>() == std::array<uint16_t, 6>{0b01, 0b10, 0b11, 0b00, 0b01, 0b10});
+    }
+
+    SECTION("The array is accessed as a whole without an index")
+    {
+        REQUIRE(r.get<reg::two>() == 0b10'01'00'11'10'01);
+        REQUIRE(r.get<reg::one>() == 0b101);
+        REQUIRE(r.get<reg::three>() == 1);
+    }
+
+    SECTION("Elements are modified in a loop, leaving the other bitfields unchanged")
+    {
+        for (unsigned pin{0}; pin < Gpio::bitfield_type<reg::two>::count; ++pin)
+            r.assign<reg::two>(pin, pin % 4);
+        REQUIRE(r() == 0b101'01'00'11'10'01'00'1);
+
+        r.set<reg::two>(0, 0b10).clear<reg::two>(1, 0b01);
+        REQUIRE(r() == 0b101'01'00'11'10'00'10'1);
+    }
+
+    SECTION("All the elements are filled at once")
+    {
+        r.fill<reg::two>(0b10);
+        REQUIRE(r() == 0b101'10'10'10'10'10'10'1);
+    }
+
+    SECTION("Indices and values are checked")
+    {
+        REQUIRE_THROWS_AS(r.get<reg::two>(6), Gpio::index_out_of_range_error);
+        REQUIRE_THROWS_AS(r.assign<reg::two>(6, 0), Gpio::index_out_of_range_error);
+        REQUIRE_THROWS_AS(r.set<reg::two>(0, 0b100), Gpio::overflow_error);
+        REQUIRE_THROWS_AS(r.clear<reg::two>(0, 0b100), Gpio::mask_not_matching_error);
+        REQUIRE_THROWS_AS(r.fill<reg::two>(0b100), Gpio::overflow_error);
+        REQUIRE(r() == 0b101'10'01'00'11'10'01'1);
+    }
+}
+
+TEST_CASE("Out of range indices are handled according to the policy", "[bitfield_array]")
+{
+    SECTION("Error code is returned")
+    {
+        Gpio::with_policy<overflow::return_error> r{0xFFFF};
+        REQUIRE(r.assign<reg::two>(7, 0) == std::errc::result_out_of_range);
+        REQUIRE(r.assign<reg::two>(0, 4) == std::errc::value_too_large);
+        REQUIRE(r.get<reg::two>(7) == 0);
+        REQUIRE(r() == 0xFFFF);
+    }
+
+    SECTION("Register is left unchanged")
+    {
+        Gpio::with_policy<overflow::truncate> r{0};
+        r.assign<reg::two>(6, 0b11).assign<reg::two>(3, 0b111);
+        REQUIRE(r() == 0b000'00'00'11'00'00'00'0);
+    }
+}
+
+TEST_CASE("Plain bitfields are arrays of one element", "[bitfield_array]")
+{
+    constexpr auto r{Gpio{}.assign<reg::one>(0, 0b110)};
+    static_assert(r.get<reg::one>(0) == 0b110);
+}
@@ -0,0 +1,22 @@
+/**
+ * @file	burst_addresses_not_ascending_compile_time.cpp
+ * @brief	Test for static assertion is triggered when addresses of registers read in bursts aren't ascending.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/memory_transport.hpp"
+#include "small_register/small_map.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+void burst_addresses_not_ascending_compile_time()
+{
+    using Reg1 = small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 6>>;
+    using Reg2 = small_register<uint8_t, bitfield<reg::three, 4>, bitfield<reg::four, 4>>;
+
+    using MemoryMap = small_map<element<0x01, Reg1>, element<0x02, Reg2>>;
+
+    memory_transport<4> bus;
+    MemoryMap::read<0x02, 0x01>(bus);
+}
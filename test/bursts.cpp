@@ -0,0 +1,86 @@
+/**
+ * @file	bursts.cpp
+ * @brief	Tests reading and writing multiple registers of a small_map, merged into burst transactions.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/memory_transport.hpp"
+#include "small_register/small_map.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg8 = small_register<uint8_t, bitfield<reg::one, 3>, bitfield<reg::two, 5>>;
+using Reg16 = small_register<uint16_t, bitfield<reg::one, 4>, bitfield<reg::two, 12>>;
+
+// 0x00, 0x01, 0x02 are adjacent; 0x02 is 16-bit so 0x04 is adjacent as well; 0x06 is separate.
+using Map = small_map<element<0x00, Reg8>,
+                      element<0x01, Reg8>,
+                      element<0x02, Reg16>,
+                      element<0x04, Reg8>,
+                      element<0x06, Reg8>>;
+
+} // namespace
+
+TEST_CASE("Registers are transferred in bursts", "[small_map][burst]")
+{
+    memory_transport<8> bus;
+    bus.memory = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+    SECTION("Single register is read")
+    {
+        auto r{Map::read<0x02>(bus)};
+
+        REQUIRE(std::is_same_v<decltype(r), Reg16>);
+        REQUIRE(r() == 0x3344);
+        REQUIRE(r.get<reg::one>() == 0x3);
+        REQUIRE(bus.reads == 1);
+    }
+
+    SECTION("Adjacent registers are read in a single transaction")
+    {
+        auto [r0, r1, r2, r4] = Map::read<0x00, 0x01, 0x02, 0x04>(bus);
+
+        REQUIRE(r0() == 0x11);
+        REQUIRE(r1() == 0x22);
+        REQUIRE(r2() == 0x3344);
+        REQUIRE(r4() == 0x55);
+        REQUIRE(bus.reads == 1);
+        REQUIRE(bus.bytes_read == 5);
+    }
+
+    SECTION("Non-adjacent registers are read in separate transactions")
+    {
+        auto [r0, r1, r4, r6] = Map::read<0x00, 0x01, 0x04, 0x06>(bus);
+
+        REQUIRE(r0() == 0x11);
+        REQUIRE(r1() == 0x22);
+        REQUIRE(r4() == 0x55);
+        REQUIRE(r6() == 0x77);
+        REQUIRE(bus.reads == 3);
+        REQUIRE(bus.bytes_read == 4);
+    }
+
+    SECTION("Registers are written in bursts")
+    {
+        Map::write<0x01, 0x02, 0x06>(bus, Reg8{0xAB}, Reg16{}.set<reg::two>(0xCDE), Reg8{0xEF});
+
+        REQUIRE(bus.writes == 2);
+        REQUIRE(bus.bytes_written == 4);
+        REQUIRE(bus.memory == std::array<uint8_t, 8>{0x11, 0xAB, 0x0C, 0xDE, 0x55, 0x66, 0xEF, 0x88});
+    }
+
+    SECTION("Written registers are read back")
+    {
+        Map::write<0x00, 0x02>(bus, Reg8{}.set<reg::one>(0b101), Reg16{0xBEEF});
+
+        auto [r0, r2] = Map::read<0x00, 0x02>(bus);
+        REQUIRE(r0.get<reg::one>() == 0b101);
+        REQUIRE(r2() == 0xBEEF);
+        REQUIRE(bus.transactions() == 4);
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file	byte_order.cpp
+ * @brief	Tests loading and storing registers from and to byte buffers, and the in-place register_ref view.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/byte_order.hpp"
+#include "small_register/register_ref.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg16 = small_register<uint16_t, bitfield<reg::one, 4>, bitfield<reg::two, 12>>;
+using Reg32 = small_register<uint32_t, bitfield<reg::one, 8>, bitfield<reg::two, 16>, bitfield<reg::three, 8>>;
+
+} // namespace
+
+TEST_CASE("Registers are loaded from and stored to byte buffers", "[byte_order]")
+{
+    const std::array<uint8_t, 4> bytes{0x12, 0x34, 0x56, 0x78};
+
+    SECTION("Big endian")
+    {
+        REQUIRE(load_be<Reg16>(bytes.data())() == 0x1234);
+        REQUIRE(load_be<Reg32>(bytes.data())() == 0x12345678);
+        REQUIRE(load_be<Reg32>(bytes.data()).get<reg::two>() == 0x3456);
+
+        std::array<uint8_t, 4> out{};
+        store_be(Reg32{0x12345678}, out.data());
+        REQUIRE(out == bytes);
+    }
+
+    SECTION("Little endian")
+    {
+        REQUIRE(load_le<Reg16>(bytes.data())() == 0x3412);
+        REQUIRE(load_le<Reg32>(bytes.data())() == 0x78563412);
+
+        std::array<uint8_t, 4> out{};
+        store_le(Reg32{0x78563412}, out.data());
+        REQUIRE(out == bytes);
+    }
+
+    SECTION("From buffers of std::byte")
+    {
+        const std::array<std::byte, 2> raw{std::byte{0xAB}, std::byte{0xCD}};
+        REQUIRE(load_be<Reg16>(raw.data())() == 0xABCD);
+
+        std::array<std::byte, 2> out{};
+        store_le(Reg16{0xABCD}, out.data());
+        REQUIRE(out[0] == std::byte{0xCD});
+        REQUIRE(out[1] == std::byte{0xAB});
+    }
+}
+
+TEST_CASE("Registers are modified in place within byte buffers", "[byte_order][register_ref]")
+{
+    std::array<uint8_t, 6> frame{0xAA, 0x12, 0x34, 0x56, 0x78, 0xBB};
+
+    SECTION("Fields are read from the buffer")
+    {
+        register_ref<Reg32> ref{frame.data() + 1};
+
+        REQUIRE(ref() == 0x12345678);
+        REQUIRE(ref.get<reg::one>() == 0x12);
+        REQUIRE(ref.get<reg::two, reg::three>() == std::tuple{0x3456u, 0x78u});
+    }
+
+    SECTION("Fields are patched without touching the neighbouring bytes")
+    {
+        register_ref<Reg32> ref{frame.data() + 1};
+        ref.assign<reg::two>(0xBEEF).clear<reg::three>().set<reg::one, 0x01>();
+
+        REQUIRE(frame == std::array<uint8_t, 6>{0xAA, 0x13, 0xBE, 0xEF, 0x00, 0xBB});
+    }
+
+    SECTION("Little endian view")
+    {
+        register_ref<Reg16, byte_order::little> ref{frame.data()};
+        ref.assign<reg::one>(0x5);
+
+        REQUIRE(frame[0] == 0xAA);
+        REQUIRE(frame[1] == 0x52);
+    }
+
+    SECTION("Errors are reported as for the register")
+    {
+        register_ref<Reg16> ref{frame.data()};
+        REQUIRE_THROWS_AS(ref.set<reg::one>(0x10), Reg16::overflow_error);
+
+        register_ref<Reg16::with_policy<overflow::return_error>> returning{frame.data()};
+        REQUIRE(returning.assign<reg::one>(0x10) == std::errc::value_too_large);
+        REQUIRE(frame[0] == 0xAA);
+    }
+}
@@ -0,0 +1,262 @@
+/**
+ * @file	capture.cpp
+ * @brief	Tests the parallel decoding of the captures of register traffic.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/capture.hpp"
+
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg8 = small_register<uint8_t, bitfield<reg::one, 3>, bitfield<reg::two, 5>>;
+using Reg16 = small_register<uint16_t, bitfield<reg::three, 4>, bitfield<reg::four, 12>>;
+using Map = small_map<element<0x02, Reg8>, element<0x00, Reg16>, element<0x105, Reg8>>;
+
+// More than two chunks, so that the threads have to split the capture.
+constexpr std::size_t records_count{150'000};
+
+std::vector<capture_record> make_capture(std::size_t count, std::uint64_t seed = 7)
+{
+    std::vector<capture_record> result(count);
+    capture_generator<Map>{seed}.generate(result.data(), result.data() + result.size());
+    return result;
+}
+
+struct summing_visitor
+{
+    void operator()(std::uint64_t timestamp, Reg8 r)
+    {
+        ++count;
+        sum += r.get<reg::two>();
+        last_timestamp = timestamp;
+    }
+
+    void operator()(std::uint64_t timestamp, Reg16 r)
+    {
+        ++count;
+        sum += r.get<reg::four>();
+        last_timestamp = timestamp;
+    }
+
+    std::size_t count{0};
+    std::uint64_t sum{0};
+    std::uint64_t last_timestamp{0};
+};
+
+struct address_visitor
+{
+    template<typename Element, typename Register>
+    void operator()(std::uint64_t, Element, Register)
+    {
+        addresses.push_back(Element::address);
+    }
+
+    std::vector<unsigned> addresses;
+};
+
+std::filesystem::path temporary_capture(const char* name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+} // namespace
+
+TEST_CASE("Synthetic captures are generated", "[capture]")
+{
+    auto capture{make_capture(1000)};
+
+    SECTION("With the addresses of the map and the values within the registers")
+    {
+        for (const auto& record : capture)
+        {
+            REQUIRE((record.address == 0x02 || record.address == 0x00 || record.address == 0x105));
+            REQUIRE(record.value <= (record.address == 0x00 ? 0xFFFFu : 0xFFu));
+        }
+    }
+
+    SECTION("With increasing timestamps")
+    {
+        for (std::size_t i{1}; i < capture.size(); ++i)
+            REQUIRE(capture[i].timestamp > capture[i - 1].timestamp);
+    }
+
+    SECTION("Deterministically")
+    {
+        auto again{make_capture(1000)};
+        REQUIRE(std::equal(capture.begin(), capture.end(), again.begin(), [](const auto& a, const auto& b) {
+            return a.timestamp == b.timestamp && a.address == b.address && a.value == b.value;
+        }));
+    }
+}
+
+TEST_CASE("Captures are decoded in parallel", "[capture]")
+{
+    auto capture{make_capture(records_count)};
+    const auto* first{capture.data()};
+    const auto* last{capture.data() + capture.size()};
+
+    summing_visitor expected;
+    for (const auto& record : capture)
+        Map::visit(record.address, record.value, [&](auto r) { expected(record.timestamp, r); });
+
+    for (unsigned threads : {1u, 3u, 0u})
+    {
+        auto visitors{decode<Map>(first, last, summing_visitor{}, threads)};
+
+        REQUIRE(visitors.size() == 3);
+        summing_visitor merged;
+        for (const auto& v : visitors)
+        {
+            merged.count += v.count;
+            merged.sum += v.sum;
+        }
+        REQUIRE(merged.count == expected.count);
+        REQUIRE(merged.sum == expected.sum);
+        REQUIRE(visitors.back().last_timestamp == expected.last_timestamp);
+    }
+}
+
+TEST_CASE("Decoded records carry the elements when the visitor accepts them", "[capture]")
+{
+    std::vector<capture_record> capture{{1, 0x02, 0b10111}, {2, 0x105, 0b00011}, {3, 0x00, 0x1234}};
+
+    auto visitors{decode<Map>(capture.data(), capture.data() + capture.size(), address_visitor{})};
+
+    REQUIRE(visitors.size() == 1);
+    REQUIRE(visitors[0].addresses == std::vector<unsigned>{0x02, 0x105, 0x00});
+}
+
+TEST_CASE("Records with addresses out of the map are skipped", "[capture]")
+{
+    // 0x10002 would alias 0x02 if truncated to the address type of the map.
+    using SmallMap = small_map<element<uint16_t{0x02}, Reg8>>;
+    std::vector<capture_record> capture{{1, 0x02, 1}, {2, 0x03, 2}, {3, 0x10002, 3}};
+
+    auto matches{filter<SmallMap>(capture.data(), capture.data() + capture.size(), [](std::uint64_t, Reg8) {
+        return true;
+    })};
+
+    REQUIRE(matches.size() == 1);
+    REQUIRE(matches[0].timestamp == 1);
+}
+
+TEST_CASE("Bitfields are extracted to columns", "[capture]")
+{
+    auto capture{make_capture(records_count)};
+
+    std::vector<std::uint64_t> timestamps;
+    std::vector<uint8_t> ones, twos;
+    for (const auto& record : capture)
+    {
+        if (record.address == 0x105)
+        {
+            Reg8 r{static_cast<uint8_t>(record.value)};
+            timestamps.push_back(record.timestamp);
+            ones.push_back(r.get<reg::one>());
+            twos.push_back(r.get<reg::two>());
+        }
+    }
+
+    for (unsigned threads : {1u, 2u, 0u})
+    {
+        auto result{columns<Map, 0x105>(capture.data(), capture.data() + capture.size(), threads)};
+
+        REQUIRE(std::equal(timestamps.begin(), timestamps.end(), result.timestamps.begin(), result.timestamps.end()));
+        REQUIRE(std::equal(ones.begin(), ones.end(), result.fields[0].begin(), result.fields[0].end()));
+        REQUIRE(std::equal(twos.begin(), twos.end(), result.fields[1].begin(), result.fields[1].end()));
+    }
+}
+
+TEST_CASE("Records are filtered in the order of the capture", "[capture]")
+{
+    auto capture{make_capture(records_count)};
+    auto is_matching{[](std::uint64_t, auto element, auto r) {
+        if constexpr (decltype(element)::address == 0x00)
+            return r.template get<reg::three>() == 0b1010;
+        else
+            return false;
+    }};
+
+    std::vector<std::uint64_t> expected;
+    for (const auto& record : capture)
+        if (record.address == 0x00 && Reg16{static_cast<uint16_t>(record.value)}.get<reg::three>() == 0b1010)
+            expected.push_back(record.timestamp);
+
+    auto matches{filter<Map>(capture.data(), capture.data() + capture.size(), is_matching, 4)};
+
+    REQUIRE(matches.size() == expected.size());
+    for (std::size_t i{0}; i < matches.size(); ++i)
+        REQUIRE(matches[i].timestamp == expected[i]);
+}
+
+TEST_CASE("Exceptions thrown by the visitors are propagated", "[capture]")
+{
+    auto capture{make_capture(records_count)};
+    auto throwing{[](std::uint64_t timestamp, auto) {
+        if (timestamp > 1000)
+            throw std::runtime_error{"Visitor failed"};
+    }};
+
+    REQUIRE_THROWS_AS(decode<Map>(capture.data(), capture.data() + capture.size(), throwing, 2), std::runtime_error);
+}
+
+TEST_CASE("Capture files are memory-mapped", "[capture]")
+{
+    auto path{temporary_capture("small_register_capture_test.bin")};
+
+    SECTION("With the records written by the generator")
+    {
+        capture_generator<Map>{7}.generate(path.c_str(), records_count);
+        mapped_capture mapped{path.c_str()};
+        auto expected{make_capture(records_count)};
+
+        REQUIRE(mapped.size() == records_count);
+        REQUIRE(std::equal(mapped.begin(), mapped.end(), expected.begin(), [](const auto& a, const auto& b) {
+            return a.timestamp == b.timestamp && a.address == b.address && a.value == b.value;
+        }));
+
+        auto result{columns<Map, 0x00>(mapped.begin(), mapped.end())};
+        REQUIRE(result.timestamps.size()
+                == static_cast<std::size_t>(std::count_if(
+                    expected.begin(), expected.end(), [](const auto& r) { return r.address == 0x00; })));
+    }
+
+    SECTION("Empty")
+    {
+        capture_generator<Map>{}.generate(path.c_str(), 0);
+        mapped_capture mapped{path.c_str()};
+
+        REQUIRE(mapped.size() == 0);
+        REQUIRE(columns<Map, 0x00>(mapped.begin(), mapped.end()).timestamps.empty());
+    }
+
+    SECTION("Unless the size isn't a multiple of the record size")
+    {
+        auto* file{std::fopen(path.c_str(), "wb")};
+        std::fputs("truncated", file);
+        std::fclose(file);
+
+        REQUIRE_THROWS_AS(mapped_capture{path.c_str()}, std::system_error);
+    }
+
+    SECTION("Unless the file doesn't exist")
+    {
+        std::filesystem::remove(path);
+        REQUIRE_THROWS_AS(mapped_capture{path.c_str()}, std::system_error);
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,16 @@
+# Additional arguments are passed to the compiler.
+function(SmallRegister_AddCodegenTest name filename)
+
+    set(test_name SmallRegister_CodegenTest_${name})
+    set(assembly_file ${CMAKE_CURRENT_BINARY_DIR}/codegen_${name}.s)
+
+    add_test(NAME ${test_name} COMMAND
+        ${CMAKE_COMMAND}
+            -DCOMPILER=${CMAKE_CXX_COMPILER}
+            -DSOURCE=${filename}
+            -DOUTPUT=${assembly_file}
+            -DINCLUDE_DIR=${PROJECT_SOURCE_DIR}
+            "-DFLAGS=${ARGN}"
+            -P ${CMAKE_CURRENT_LIST_DIR}/codegen_check.cmake)
+
+endfunction()
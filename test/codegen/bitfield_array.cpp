@@ -0,0 +1,46 @@
+/**
+ * @file	bitfield_array.cpp
+ * @brief	Input for the generated-code test which checks that the elements of bitfield arrays are accessed with plain
+ *          shifts computed from the index. Compiled with "-fno-exceptions -DNDEBUG".
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/small_register.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class gpio
+{
+    mode,
+    lock
+};
+
+// Modes of 15 pins, 2 bits each, and the lock bit.
+using Modes = basic_small_register<overflow::unchecked, uint32_t, bitfield_array<gpio::mode, 2, 15>, bitfield<gpio::lock, 2>>;
+
+} // namespace
+
+extern "C" uint32_t get_small_register(uint32_t reg, std::size_t pin)
+{
+    return Modes{reg}.get<gpio::mode>(pin);
+}
+
+extern "C" uint32_t get_hand_written(uint32_t reg, std::size_t pin)
+{
+    return pin < 15 ? (reg >> (2 + 2 * pin)) & 0x3 : 0;
+}
+
+extern "C" uint32_t fill_small_register(uint32_t reg, uint32_t mode)
+{
+    return Modes{reg}.fill<gpio::mode>(mode)();
+}
+
+extern "C" uint32_t fill_hand_written(uint32_t reg, uint32_t mode)
+{
+    return (reg & 0x3) | ((mode * 0x15555555u) << 2);
+}
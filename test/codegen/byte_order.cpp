@@ -0,0 +1,86 @@
+/**
+ * @file	byte_order.cpp
+ * @brief	Input for the generated-code test which checks that loading, storing and patching registers in byte buffers
+ *          is as cheap as hand-written code using a byte swap. Compiled with "-fno-exceptions -DNDEBUG".
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/register_ref.hpp"
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class header
+{
+    version,
+    length,
+    flags
+};
+
+using Header = basic_small_register<overflow::unchecked,
+                                    uint32_t,
+                                    bitfield<header::version, 4>,
+                                    bitfield<header::length, 20>,
+                                    bitfield<header::flags, 8>>;
+
+} // namespace
+
+extern "C" uint32_t load_be_small_register(const uint8_t* data)
+{
+    auto h{load_be<Header>(data)};
+    return h.get<header::length>();
+}
+
+extern "C" uint32_t load_be_hand_written(const uint8_t* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    value = __builtin_bswap32(value);
+    return (value >> 8) & 0xFFFFF;
+}
+
+extern "C" uint32_t load_le_small_register(const uint8_t* data)
+{
+    auto h{load_le<Header>(data)};
+    return h.get<header::length>();
+}
+
+extern "C" uint32_t load_le_hand_written(const uint8_t* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return (value >> 8) & 0xFFFFF;
+}
+
+extern "C" void store_be_small_register(uint32_t value, uint8_t* data)
+{
+    Header h{value};
+    store_be(h, data);
+}
+
+extern "C" void store_be_hand_written(uint32_t value, uint8_t* data)
+{
+    value = __builtin_bswap32(value);
+    std::memcpy(data, &value, sizeof(value));
+}
+
+extern "C" void patch_small_register(uint8_t* data, uint32_t length)
+{
+    register_ref<Header> h{data};
+    h.assign<header::length>(length);
+}
+
+extern "C" void patch_hand_written(uint8_t* data, uint32_t length)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    value = __builtin_bswap32(value);
+    value = (value & 0xF00000FF) | (length << 8);
+    value = __builtin_bswap32(value);
+    std::memcpy(data, &value, sizeof(value));
+}
@@ -0,0 +1,85 @@
+/**
+ * @file	chaining.cpp
+ * @brief	Input for the generated-code test comparing chained operations against hand-written bit operations, and
+ *          checking that no throwing path remains when the chained operations get only constants.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class cfg
+{
+    mode,
+    enable,
+    gain,
+    channel,
+    threshold
+};
+
+using Config = small_register<uint32_t,
+                              bitfield<cfg::mode, 3>,
+                              bitfield<cfg::enable, 1>,
+                              bitfield<cfg::gain, 4>,
+                              bitfield<cfg::channel, 8>,
+                              bitfield<cfg::threshold, 16>>;
+
+} // namespace
+
+extern "C" uint32_t chain_small_register(uint32_t reg, uint32_t gain, uint32_t threshold)
+{
+    Config r{reg};
+    r.clear<cfg::mode>().set<cfg::enable>().assign<cfg::gain>(gain).assign<cfg::threshold>(threshold);
+    return r();
+}
+
+extern "C" uint32_t chain_hand_written(uint32_t reg, uint32_t gain, uint32_t threshold)
+{
+    reg = (reg & ~0xE000'0000) | 0x1000'0000;
+    if ((gain & ~0xF) != 0)
+        throw Config::overflow_error{};
+    reg = (reg & ~0x0F00'0000) | (gain << 24);
+    if ((threshold & ~0xFFFF) != 0)
+        throw Config::overflow_error{};
+    return (reg & ~0xFFFF) | threshold;
+}
+
+extern "C" uint32_t get_after_chain_small_register(uint32_t reg, uint32_t channel)
+{
+    Config r{reg};
+    return r.set<cfg::channel>(channel).clear<cfg::gain>().get<cfg::channel>();
+}
+
+extern "C" uint32_t get_after_chain_hand_written(uint32_t reg, uint32_t channel)
+{
+    if ((channel & ~0xFF) != 0)
+        throw Config::overflow_error{};
+    return ((reg | (channel << 16)) >> 16) & 0xFF;
+}
+
+extern "C" uint32_t constant_chain_small_register(uint32_t reg)
+{
+    Config r{reg};
+    r.assign<cfg::mode>(0b101).set<cfg::enable>().clear<cfg::gain>(0b0110).assign<cfg::threshold>(0x1234);
+    return r();
+}
+
+extern "C" uint32_t constant_chain_hand_written(uint32_t reg)
+{
+    return (reg & 0x09FF'0000) | 0xB000'1234;
+}
+
+extern "C" uint32_t constant_set_small_register(uint32_t reg)
+{
+    return Config{reg}.set<cfg::channel>(0x80).set<cfg::gain>(0x1)();
+}
+
+extern "C" uint32_t constant_set_hand_written(uint32_t reg)
+{
+    return reg | 0x0180'0000;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file	deferred.cpp
+ * @brief	Input for the generated-code test which checks that a deferred chain on a memory-mapped register performs a
+ *          single volatile load and store, as the hand-written code. Compiled with "-fno-exceptions -DNDEBUG".
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/deferred.hpp"
+#include "small_register/mmio_register.hpp"
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class ctrl
+{
+    enable,
+    mode,
+    prescaler,
+    reserved
+};
+
+using Control = basic_small_register<overflow::unchecked,
+                                     uint32_t,
+                                     bitfield<ctrl::enable, 1>,
+                                     bitfield<ctrl::mode, 3>,
+                                     bitfield<ctrl::prescaler, 12>,
+                                     bitfield<ctrl::reserved, 16>>;
+
+} // namespace
+
+extern "C" void chain_small_register(volatile uint32_t* address, uint32_t prescaler)
+{
+    mmio_register<Control> r{address};
+    defer(r).set<ctrl::mode>().clear<ctrl::enable>().assign<ctrl::prescaler>(prescaler);
+}
+
+extern "C" void chain_hand_written(volatile uint32_t* address, uint32_t prescaler)
+{
+    *address = (*address & 0x0000FFFF) | 0x70000000 | (prescaler << 16);
+}
+
+extern "C" void overwrite_small_register(volatile uint32_t* address, uint32_t mode)
+{
+    mmio_register<Control> r{address};
+    defer(r).assign<ctrl::enable, ctrl::mode>(1, mode).assign<ctrl::prescaler, ctrl::reserved>(0, 0xABCD);
+}
+
+extern "C" void overwrite_hand_written(volatile uint32_t* address, uint32_t mode)
+{
+    *address = 0x8000ABCD | (mode << 28);
+}
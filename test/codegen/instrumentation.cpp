@@ -0,0 +1,55 @@
+/**
+ * @file	instrumentation.cpp
+ * @brief	Input for the generated-code test which checks that the instrumentation without a tracer generates the same
+ *          code as the bare overflow policy. Compiled with "-fno-exceptions -DNDEBUG".
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class cc1
+{
+    icc,
+    en_ntc,
+    ipre
+};
+
+template<typename Policy>
+using ChargeControl1 =
+    basic_small_register<Policy, uint8_t, bitfield<cc1::icc, 5>, bitfield<cc1::en_ntc, 1>, bitfield<cc1::ipre, 2>>;
+
+} // namespace
+
+extern "C" uint8_t disabled_unchecked_small_register(uint8_t reg, uint8_t icc, uint8_t ipre)
+{
+    ChargeControl1<instrumented<overflow::unchecked, void>> r{reg};
+    r.assign<cc1::icc>(icc).set<cc1::en_ntc>().clear<cc1::ipre>(ipre);
+    return static_cast<uint8_t>(r() + r.get<cc1::en_ntc>());
+}
+
+extern "C" uint8_t disabled_unchecked_reference(uint8_t reg, uint8_t icc, uint8_t ipre)
+{
+    ChargeControl1<overflow::unchecked> r{reg};
+    r.assign<cc1::icc>(icc).set<cc1::en_ntc>().clear<cc1::ipre>(ipre);
+    return static_cast<uint8_t>(r() + r.get<cc1::en_ntc>());
+}
+
+extern "C" uint8_t disabled_truncate_small_register(uint8_t reg, uint8_t icc, uint8_t ipre)
+{
+    ChargeControl1<instrumented<overflow::truncate, void>> r{reg};
+    r.assign<cc1::icc, cc1::ipre>(icc, ipre);
+    return r();
+}
+
+extern "C" uint8_t disabled_truncate_reference(uint8_t reg, uint8_t icc, uint8_t ipre)
+{
+    ChargeControl1<overflow::truncate> r{reg};
+    r.assign<cc1::icc, cc1::ipre>(icc, ipre);
+    return r();
+}
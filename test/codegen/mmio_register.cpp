@@ -0,0 +1,76 @@
+/**
+ * @file	mmio_register.cpp
+ * @brief	Input for the generated-code test which checks that the operations on memory-mapped registers perform a single
+ *          volatile load and store, as the hand-written code. Compiled with "-fno-exceptions -DNDEBUG".
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/mmio_register.hpp"
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class ctrl
+{
+    enable,
+    mode,
+    prescaler,
+    reserved
+};
+
+using Control = basic_small_register<overflow::unchecked,
+                                     uint32_t,
+                                     bitfield<ctrl::enable, 1>,
+                                     bitfield<ctrl::mode, 3>,
+                                     bitfield<ctrl::prescaler, 12>,
+                                     bitfield<ctrl::reserved, 16>>;
+
+} // namespace
+
+extern "C" void assign_small_register(volatile uint32_t* address, uint32_t mode, uint32_t prescaler)
+{
+    mmio_register<Control> r{address};
+    r.assign<ctrl::mode, ctrl::prescaler>(mode, prescaler);
+}
+
+extern "C" void assign_hand_written(volatile uint32_t* address, uint32_t mode, uint32_t prescaler)
+{
+    *address = (*address & 0x8000FFFF) | (mode << 28) | (prescaler << 16);
+}
+
+extern "C" void set_small_register(volatile uint32_t* address)
+{
+    mmio_register<Control> r{address};
+    r.set<ctrl::enable>();
+}
+
+extern "C" void set_hand_written(volatile uint32_t* address)
+{
+    *address = *address | 0x80000000;
+}
+
+extern "C" void set_only_small_register(volatile uint32_t* address, volatile uint32_t* set_alias)
+{
+    mmio_register<Control> r{address, set_alias};
+    r.set_only<ctrl::enable, ctrl::mode>();
+}
+
+extern "C" void set_only_hand_written(volatile uint32_t*, volatile uint32_t* set_alias)
+{
+    *set_alias = 0xF0000000;
+}
+
+extern "C" uint32_t get_small_register(volatile uint32_t* address)
+{
+    mmio_register<Control> r{address};
+    return r.get<ctrl::prescaler>();
+}
+
+extern "C" uint32_t get_hand_written(volatile uint32_t* address)
+{
+    return (*address >> 16) & 0xFFF;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file	multi_field.cpp
+ * @brief	Input for the generated-code test comparing multi-bitfield operations against hand-written bit operations.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class cc1
+{
+    icc,
+    en_ntc,
+    ipre
+};
+
+using ChargeControl1 = small_register<uint8_t, bitfield<cc1::icc, 5>, bitfield<cc1::en_ntc, 1>, bitfield<cc1::ipre, 2>>;
+
+} // namespace
+
+extern "C" uint8_t assign_small_register(uint8_t reg, uint8_t icc, uint8_t ipre)
+{
+    return ChargeControl1{reg}.assign<cc1::icc, cc1::ipre>(icc, ipre)();
+}
+
+extern "C" uint8_t assign_hand_written(uint8_t reg, uint8_t icc, uint8_t ipre)
+{
+    if (((icc & ~0x1F) | (ipre & ~0x03)) != 0)
+        throw ChargeControl1::overflow_error{};
+    return static_cast<uint8_t>((reg & ~0xFB) | (icc << 3) | ipre);
+}
+
+extern "C" void assign_volatile_small_register(volatile uint8_t* reg, uint8_t icc, uint8_t ipre)
+{
+    *reg = ChargeControl1{*reg}.assign<cc1::icc, cc1::ipre>(icc, ipre)();
+}
+
+extern "C" void assign_volatile_hand_written(volatile uint8_t* reg, uint8_t icc, uint8_t ipre)
+{
+    uint8_t value{*reg};
+    if (((icc & ~0x1F) | (ipre & ~0x03)) != 0)
+        throw ChargeControl1::overflow_error{};
+    *reg = static_cast<uint8_t>((value & ~0xFB) | (icc << 3) | ipre);
+}
+
+extern "C" void set_whole_volatile_small_register(volatile uint8_t* reg)
+{
+    *reg = ChargeControl1{*reg}.set<cc1::icc, cc1::ipre>()();
+}
+
+extern "C" void set_whole_volatile_hand_written(volatile uint8_t* reg)
+{
+    *reg = static_cast<uint8_t>(*reg | 0xFB);
+}
+
+extern "C" void clear_whole_volatile_small_register(volatile uint8_t* reg)
+{
+    *reg = ChargeControl1{*reg}.clear<cc1::en_ntc, cc1::ipre>()();
+}
+
+extern "C" void clear_whole_volatile_hand_written(volatile uint8_t* reg)
+{
+    *reg = static_cast<uint8_t>(*reg & ~0x07);
+}
+
+extern "C" uint8_t get_sum_small_register(uint8_t reg)
+{
+    auto [icc, ipre] = ChargeControl1{reg}.get<cc1::icc, cc1::ipre>();
+    return static_cast<uint8_t>(icc + ipre);
+}
+
+extern "C" uint8_t get_sum_hand_written(uint8_t reg)
+{
+    return static_cast<uint8_t>((reg >> 3) + (reg & 0x03));
+}
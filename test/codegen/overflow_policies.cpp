@@ -0,0 +1,75 @@
+/**
+ * @file	overflow_policies.cpp
+ * @brief	Input for the generated-code test which checks that the unchecked and the compile-time operations have no
+ *          branches. Compiled with "-fno-exceptions -DNDEBUG".
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class cc1
+{
+    icc,
+    en_ntc,
+    ipre
+};
+
+template<typename Policy>
+using ChargeControl1 =
+    basic_small_register<Policy, uint8_t, bitfield<cc1::icc, 5>, bitfield<cc1::en_ntc, 1>, bitfield<cc1::ipre, 2>>;
+
+} // namespace
+
+extern "C" uint8_t unchecked_set_small_register(uint8_t reg, uint8_t icc)
+{
+    ChargeControl1<overflow::unchecked> r{reg};
+    r.set<cc1::icc>(icc);
+    return r();
+}
+
+extern "C" uint8_t unchecked_set_hand_written(uint8_t reg, uint8_t icc)
+{
+    return static_cast<uint8_t>(reg | (icc << 3));
+}
+
+extern "C" uint8_t unchecked_assign_small_register(uint8_t reg, uint8_t icc, uint8_t ipre)
+{
+    ChargeControl1<overflow::unchecked> r{reg};
+    r.assign<cc1::icc, cc1::ipre>(icc, ipre);
+    return r();
+}
+
+extern "C" uint8_t unchecked_assign_hand_written(uint8_t reg, uint8_t icc, uint8_t ipre)
+{
+    return static_cast<uint8_t>((reg & 0x04) | (icc << 3) | ipre);
+}
+
+extern "C" uint8_t truncate_assign_small_register(uint8_t reg, uint8_t icc)
+{
+    ChargeControl1<overflow::truncate> r{reg};
+    r.assign<cc1::icc>(icc);
+    return r();
+}
+
+extern "C" uint8_t truncate_assign_hand_written(uint8_t reg, uint8_t icc)
+{
+    return static_cast<uint8_t>((reg & 0x07) | ((icc & 0x1F) << 3));
+}
+
+extern "C" uint8_t compile_time_assign_small_register(uint8_t reg)
+{
+    ChargeControl1<overflow::throw_error> r{reg};
+    r.assign<cc1::icc, 0b10100>().set<cc1::ipre, 0b01>();
+    return r();
+}
+
+extern "C" uint8_t compile_time_assign_hand_written(uint8_t reg)
+{
+    return static_cast<uint8_t>((reg & 0x07) | 0xA1);
+}
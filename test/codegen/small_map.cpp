@@ -0,0 +1,83 @@
+/**
+ * @file	small_map.cpp
+ * @brief	Input for the generated-code test comparing registers looked up and read through small_map against
+ *          hand-written bit operations on a register image.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/small_map.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class ctl
+{
+    icc,
+    en_ntc,
+    ipre
+};
+
+enum class stat
+{
+    vin,
+    chg,
+    ntc
+};
+
+using ChargeControl = small_register<uint8_t, bitfield<ctl::icc, 5>, bitfield<ctl::en_ntc, 1>, bitfield<ctl::ipre, 2>>;
+using Status = small_register<uint16_t, bitfield<stat::vin, 10>, bitfield<stat::chg, 2>, bitfield<stat::ntc, 4>>;
+
+using Map = small_map<element<0x01, ChargeControl>, element<0x02, Status>, element<0x05, ChargeControl>>;
+
+//! Reads the registers from an image of the device memory, so that the whole read can be inlined.
+struct image_transport
+{
+    void read(uint8_t address, uint8_t* data, std::size_t size)
+    {
+        std::memcpy(data, image + address, size);
+    }
+
+    const uint8_t* image;
+};
+
+} // namespace
+
+extern "C" uint8_t lookup_small_register(uint8_t raw, uint8_t icc)
+{
+    Map::register_from_address<0x05>::type r{raw};
+    return r.assign<ctl::icc>(icc)();
+}
+
+extern "C" uint8_t lookup_hand_written(uint8_t raw, uint8_t icc)
+{
+    if ((icc & ~0x1F) != 0)
+        throw ChargeControl::overflow_error{};
+    return static_cast<uint8_t>((raw & 0x07) | (icc << 3));
+}
+
+extern "C" uint8_t constant_lookup_small_register(uint8_t raw)
+{
+    Map::register_from_address<0x01>::type r{raw};
+    return r.assign<ctl::icc>(0x11).set<ctl::ipre>(0b10)();
+}
+
+extern "C" uint8_t constant_lookup_hand_written(uint8_t raw)
+{
+    return static_cast<uint8_t>((raw & 0x07) | 0x8A);
+}
+
+extern "C" unsigned burst_small_register(const uint8_t* image)
+{
+    image_transport bus{image};
+    auto [control, status] = Map::read<0x01, 0x02>(bus);
+    return control.get<ctl::icc>() + status.get<stat::chg>();
+}
+
+extern "C" unsigned burst_hand_written(const uint8_t* image)
+{
+    return static_cast<unsigned>((image[0x01] >> 3) + ((image[0x03] >> 4) & 0x03));
+}
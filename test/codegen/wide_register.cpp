@@ -0,0 +1,78 @@
+/**
+ * @file	wide_register.cpp
+ * @brief	Input for the generated-code test which checks that bitfields spanning the word boundaries are accessed
+ *          with at most two word operations, as in hand-written code. Compiled with "-fno-exceptions -DNDEBUG
+ *          -fno-tree-slp-vectorize", so that the pairs of 64-bit operations are compared as scalar code.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/wide_register.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class field
+{
+    kind,
+    timestamp,
+    payload
+};
+
+using Words = std::array<uint64_t, 2>;
+using Bytes = std::array<uint8_t, 16>;
+
+template<typename Storage>
+using Message = basic_wide_register<overflow::unchecked,
+                                    Storage,
+                                    bitfield<field::kind, 12>,
+                                    bitfield<field::timestamp, 64>,
+                                    bitfield<field::payload, 52>>;
+
+} // namespace
+
+extern "C" uint64_t get_words_small_register(const uint64_t* words)
+{
+    Message<Words> m{{words[0], words[1]}};
+    return m.get<field::timestamp>();
+}
+
+extern "C" uint64_t get_words_hand_written(const uint64_t* words)
+{
+    return (words[0] << 12) | (words[1] >> 52);
+}
+
+extern "C" void assign_words_small_register(uint64_t* words, uint64_t timestamp)
+{
+    Message<Words> m{{words[0], words[1]}};
+    m.assign<field::timestamp>(timestamp);
+    words[0] = m()[0];
+    words[1] = m()[1];
+}
+
+extern "C" void assign_words_hand_written(uint64_t* words, uint64_t timestamp)
+{
+    auto first{words[0]};
+    auto second{words[1]};
+    words[0] = (first & 0xFFF0'0000'0000'0000) | (timestamp >> 12);
+    words[1] = (second & 0x000F'FFFF'FFFF'FFFF) | (timestamp << 52);
+}
+
+extern "C" uint64_t get_bytes_small_register(const uint8_t* bytes)
+{
+    Bytes frame;
+    std::memcpy(frame.data(), bytes, frame.size());
+    Message<Bytes> m{frame};
+    return m.get<field::payload>();
+}
+
+extern "C" uint64_t get_bytes_hand_written(const uint8_t* bytes)
+{
+    uint64_t value;
+    std::memcpy(&value, bytes + 8, sizeof(value));
+    return __builtin_bswap64(value) & 0x000F'FFFF'FFFF'FFFF;
+}
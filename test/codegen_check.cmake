@@ -0,0 +1,104 @@
+cmake_minimum_required(VERSION 3.16)
+
+# Compiles SOURCE to assembly at -O2 and, for each function "<case>_small_register", checks that it has the same
+# number of instructions, branches and calls as the function "<case>_hand_written". The functions shall have C linkage.
+#
+# Moves between registers are not counted, because their number depends on the register allocation, which differs
+# even for equivalent expressions.
+#
+# Only the hot path is compared: the fragments outlined by the compiler (e.g. "*.cold" holding the throwing paths)
+# are laid out differently for the code coming from templates and for the hand-written code.
+#
+# A case can have the function "<case>_reference" instead of "<case>_hand_written", built with the library too, e.g.
+# without a feature which shall generate no code. Then the instructions of both functions shall be the same, not only
+# their number.
+#
+# The cases named "constant_<case>" pass only constants to the operations, so additionally the "_small_register"
+# function shall have no calls, no branches and no outlined fragments: no exception can be thrown, whatever the overflow
+# policy.
+
+execute_process(
+    COMMAND ${COMPILER} -std=c++17 -O2 ${FLAGS} -S -I${INCLUDE_DIR} -o ${OUTPUT} ${SOURCE}
+    RESULT_VARIABLE result
+    ERROR_VARIABLE error)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Compilation of ${SOURCE} failed:\n${error}")
+endif()
+
+file(STRINGS ${OUTPUT} lines)
+
+set(current_function "")
+set(functions "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^([A-Za-z_][A-Za-z0-9_]*)\\.cold[.0-9]*:")
+        set(cold_${CMAKE_MATCH_1} TRUE)
+        set(current_function "")
+    elseif(line MATCHES "^([A-Za-z_][A-Za-z0-9_]*):")
+        set(current_function ${CMAKE_MATCH_1})
+        set(count_${current_function} 0)
+        set(calls_${current_function} 0)
+        set(branches_${current_function} 0)
+        set(body_${current_function} "")
+        list(APPEND functions ${current_function})
+    elseif(line MATCHES "^[ \t]*\\.(size|cfi_endproc)" OR line MATCHES "^[A-Za-z_]")
+        set(current_function "")
+    elseif(current_function AND line MATCHES "^[ \t]+[a-z]")
+        if(line MATCHES "^[ \t]+mov[a-z]*[ \t]+%[a-z0-9]+, *%[a-z0-9]+$"
+           OR line MATCHES "^[ \t]+mov[ \t]+[wx][0-9]+, *[wx][0-9]+$")
+            continue()
+        endif()
+        math(EXPR count_${current_function} "${count_${current_function}} + 1")
+        if(line MATCHES "^[ \t]+(call|bl)[ \t]")
+            math(EXPR calls_${current_function} "${calls_${current_function}} + 1")
+        elseif(line MATCHES "^[ \t]+(j[a-z]+|b\\.[a-z]+|cb[n]?z|tb[n]?z)[ \t]")
+            math(EXPR branches_${current_function} "${branches_${current_function}} + 1")
+        endif()
+        string(APPEND body_${current_function} "${line}\n")
+    endif()
+endforeach()
+
+set(compared 0)
+foreach(function IN LISTS functions)
+    if(NOT function MATCHES "^(.+)_small_register$")
+        continue()
+    endif()
+
+    set(reference ${CMAKE_MATCH_1}_hand_written)
+    if(${CMAKE_MATCH_1}_reference IN_LIST functions)
+        set(reference ${CMAKE_MATCH_1}_reference)
+        # The local labels are numbered through the whole file.
+        string(REGEX REPLACE "\\.L[0-9]+" ".L" body ${body_${function}})
+        string(REGEX REPLACE "\\.L[0-9]+" ".L" reference_body ${body_${reference}})
+        if(NOT body STREQUAL reference_body)
+            message(FATAL_ERROR
+                "${function} differs from ${reference}:\n${body_${function}}\n${reference}:\n${body_${reference}}")
+        endif()
+    elseif(NOT reference IN_LIST functions)
+        message(FATAL_ERROR "${function} has no ${reference} counterpart")
+    endif()
+
+    if(NOT count_${function} EQUAL count_${reference}
+       OR NOT calls_${function} EQUAL calls_${reference}
+       OR NOT branches_${function} EQUAL branches_${reference})
+        message(FATAL_ERROR
+            "${function}: ${count_${function}} instructions "
+            "(${branches_${function}} branches, ${calls_${function}} calls), "
+            "${reference}: ${count_${reference}} instructions "
+            "(${branches_${reference}} branches, ${calls_${reference}} calls)\n"
+            "${function}:\n${body_${function}}\n${reference}:\n${body_${reference}}")
+    endif()
+
+    if(function MATCHES "^constant_"
+       AND (NOT calls_${function} EQUAL 0 OR NOT branches_${function} EQUAL 0 OR cold_${function}))
+        message(FATAL_ERROR
+            "${function} takes only constants, but has ${calls_${function}} calls, ${branches_${function}} branches"
+            " or an outlined throwing path:\n${body_${function}}")
+    endif()
+    math(EXPR compared "${compared} + 1")
+endforeach()
+
+if(compared EQUAL 0)
+    message(FATAL_ERROR "No <case>_small_register functions found in ${SOURCE}")
+endif()
+
+message(STATUS "${compared} functions match their hand-written or reference equivalents")
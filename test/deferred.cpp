@@ -0,0 +1,95 @@
+/**
+ * @file	deferred.cpp
+ * @brief	Tests folding the chains of operations into a single access to the register.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/atomic_small_register.hpp"
+#include "small_register/deferred.hpp"
+#include "small_register/mmio_register.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <system_error>
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg = small_register<uint16_t, bitfield<reg::one, 4>, bitfield<reg::two, 4>, bitfield<reg::three, 8>>;
+
+} // namespace
+
+TEST_CASE("Deferred chains give the same result as the chains performed directly", "[deferred]")
+{
+    Reg direct{0xA5C3};
+    Reg folded{direct};
+
+    direct.set<reg::one>().clear<reg::two>(0b0101).assign<reg::three>(0x12).set<reg::two>(0b1000).clear<reg::one>(0b1);
+    defer(folded).set<reg::one>().clear<reg::two>(0b0101).assign<reg::three>(0x12).set<reg::two>(0b1000).clear<reg::one>(
+        0b1);
+
+    REQUIRE(folded() == direct());
+}
+
+TEST_CASE("Deferred chains access the memory-mapped register once", "[deferred]")
+{
+    volatile uint16_t memory{0x1234};
+    mmio_register<Reg, counting_access> r{&memory};
+    counting_access::reset();
+
+    SECTION("Chain is committed at the end of the expression with a single read-modify-write")
+    {
+        defer(r).set<reg::one>().clear<reg::two>(0b0010).assign<reg::three, 0xAB>();
+        REQUIRE(memory == 0xF0AB);
+        REQUIRE(counting_access::loads == 1);
+        REQUIRE(counting_access::stores == 1);
+    }
+
+    SECTION("Chain overwriting all the bitfields is committed without a load")
+    {
+        defer(r).assign<reg::one, reg::two>(0x1, 0x2).set<reg::three>().clear<reg::three>(0xFC);
+        REQUIRE(memory == 0x1203);
+        REQUIRE(counting_access::loads == 0);
+        REQUIRE(counting_access::stores == 1);
+    }
+
+    SECTION("Chain is committed explicitly, once")
+    {
+        auto update{defer(r)};
+        update.set<reg::three>(0x0F);
+        update.apply();
+        REQUIRE(memory == 0x123F);
+        update.apply();
+        REQUIRE(counting_access::stores == 1);
+    }
+
+    SECTION("Nothing is committed when an operation throws")
+    {
+        REQUIRE_THROWS_AS(defer(r).clear<reg::one>().set<reg::two>(0x10), Reg::overflow_error);
+        REQUIRE(memory == 0x1234);
+        REQUIRE(counting_access::stores == 0);
+    }
+}
+
+TEST_CASE("Failed operations of deferred chains are not accumulated", "[deferred]")
+{
+    using Checked = Reg::with_policy<overflow::return_error>;
+    Checked r{0x0000};
+    {
+        auto update{defer(r)};
+        update.set<reg::one>();
+        REQUIRE(update.assign<reg::three>(0x100) == std::errc::value_too_large);
+    }
+    REQUIRE(r() == 0xF000);
+}
+
+TEST_CASE("Deferred chains modify the atomic register at once", "[deferred]")
+{
+    atomic_small_register<Reg> r{Reg{0x00FF}};
+    defer(r).set<reg::one>().clear<reg::three>(0x0F).set<reg::two>(0x3);
+    REQUIRE(r.load()() == 0xF3F0);
+}
@@ -0,0 +1,20 @@
+/**
+ * @file	duplicated_map_addresses_compile_time.cpp
+ * @brief	Test for static assertion is triggered when two registers of a map have the same address.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/small_map.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+void duplicated_map_addresses_compile_time()
+{
+    using Reg1 = small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 6>>;
+    using Reg2 = small_register<uint8_t, bitfield<reg::three, 4>, bitfield<reg::four, 4>>;
+
+    using MemoryMap = small_map<element<0x01, Reg1>, element<0x01, Reg2>>;
+
+    MemoryMap::register_from_address<0x01>::type{};
+}
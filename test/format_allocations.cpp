@@ -0,0 +1,78 @@
+/**
+ * @file	format_allocations.cpp
+ * @brief	Tests that formatting the registers and the snapshots of maps doesn't allocate. Built as a separate
+ *          executable, as it replaces the global operator new.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/format.hpp"
+#include "small_register/register_file.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <ratio>
+#include <system_error>
+
+using namespace jungles;
+
+namespace
+{
+
+std::size_t allocations{0};
+
+inline constexpr char icc[]{"icc"};
+inline constexpr char ipre[]{"ipre"};
+
+using ChargeControl =
+    small_register<uint8_t, bitfield<reg::one, 5, icc>, bitfield<reg::two, 1>, bitfield<reg::three, 2, ipre>>;
+using Sensor = small_register<uint16_t,
+                              signed_bitfield<reg::four, 8>,
+                              scaled_bitfield<reg::five, 4, std::ratio<1, 2>>,
+                              bitfield<reg::six, 4>>;
+using Map = small_map<element<0x01, ChargeControl>, element<0x1A, Sensor>>;
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (auto* memory{std::malloc(size == 0 ? 1 : size)})
+        return memory;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+TEST_CASE("Formatting doesn't allocate", "[format]")
+{
+    char buffer[256];
+    register_file<Map> registers;
+    registers.load<0x01>(ChargeControl{0b10100'1'01});
+    registers.load<0x1A>(Sensor{0xFE'3'7});
+
+    auto before{allocations};
+    auto text{format(std::begin(buffer), std::end(buffer), ChargeControl{0b10100'1'01})};
+    auto json{format<format_style::json>(std::begin(buffer), std::end(buffer), registers)};
+    auto header{format_header<register_file<Map>>(std::begin(buffer), std::end(buffer))};
+    auto after{allocations};
+
+    REQUIRE(after == before);
+    REQUIRE(text.ec == std::errc{});
+    REQUIRE(json.ec == std::errc{});
+    REQUIRE(header.ec == std::errc{});
+}
@@ -0,0 +1,117 @@
+/**
+ * @file	formatting.cpp
+ * @brief	Tests formatting the registers and the snapshots of maps to text, JSON and CSV.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/format.hpp"
+#include "small_register/register_file.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <ratio>
+#include <string_view>
+#include <system_error>
+
+using namespace jungles;
+
+namespace
+{
+
+inline constexpr char icc[]{"icc"};
+inline constexpr char en_ntc[]{"en_ntc"};
+inline constexpr char ipre[]{"ipre"};
+inline constexpr char temperature[]{"temperature"};
+inline constexpr char voltage[]{"voltage"};
+
+using ChargeControl =
+    small_register<uint8_t, bitfield<reg::one, 5, icc>, bitfield<reg::two, 1, en_ntc>, bitfield<reg::three, 2, ipre>>;
+
+// Without names, so the numeric IDs are written.
+using Sensor = small_register<uint16_t,
+                              signed_bitfield<reg::four, 8>,
+                              scaled_bitfield<reg::five, 4, std::ratio<1, 2>>,
+                              bitfield<reg::six, 4>>;
+
+using NamedSensor = small_register<uint16_t,
+                                   signed_bitfield<reg::four, 8, std::ratio<1>, std::ratio<0>, temperature>,
+                                   scaled_bitfield<reg::five, 4, std::ratio<1, 2>, std::ratio<0>, voltage>,
+                                   bitfield<reg::six, 4>>;
+
+using Map = small_map<element<0x01, ChargeControl>, element<0x1A, Sensor>>;
+
+template<format_style Style, typename Registers>
+std::string_view format_to(char (&buffer)[128], const Registers& registers)
+{
+    auto [end, error] = format<Style>(std::begin(buffer), std::end(buffer), registers);
+    REQUIRE(error == std::errc{});
+    return {buffer, static_cast<std::size_t>(end - buffer)};
+}
+
+} // namespace
+
+TEST_CASE("Registers are formatted", "[format]")
+{
+    char buffer[128];
+    ChargeControl charge_control{0b10100'1'01};
+
+    REQUIRE(format_to<format_style::text>(buffer, charge_control) == "icc=20 en_ntc=1 ipre=1");
+    REQUIRE(format_to<format_style::json>(buffer, charge_control) == R"({"icc":20,"en_ntc":1,"ipre":1})");
+    REQUIRE(format_to<format_style::csv>(buffer, charge_control) == "20,1,1");
+
+    SECTION("Signed and scaled values are written as numbers, IDs as integers without names")
+    {
+        Sensor sensor{0xFE'3'7};
+        REQUIRE(format_to<format_style::text>(buffer, sensor) == "3=-2 4=1.5 5=7");
+    }
+
+    SECTION("Signed and scaled bitfields can be named")
+    {
+        NamedSensor sensor{0xFE'3'7};
+        REQUIRE(format_to<format_style::json>(buffer, sensor) == R"({"temperature":-2,"voltage":1.5,"5":7})");
+    }
+
+    SECTION("CSV header is written")
+    {
+        auto [end, error] = format_header<ChargeControl>(std::begin(buffer), std::end(buffer));
+        REQUIRE(error == std::errc{});
+        REQUIRE(std::string_view(buffer, static_cast<std::size_t>(end - buffer)) == "icc,en_ntc,ipre");
+    }
+
+    SECTION("Too small buffer is reported")
+    {
+        char small[10];
+        auto [end, error] = format<format_style::json>(std::begin(small), std::end(small), charge_control);
+        REQUIRE(error == std::errc::value_too_large);
+        REQUIRE(end == std::end(small));
+    }
+}
+
+TEST_CASE("Snapshots of maps are formatted", "[format]")
+{
+    char buffer[128];
+    register_file<Map> registers;
+    registers.load<0x01>(ChargeControl{0b00011'0'10});
+    registers.load<0x1A>(Sensor{0x01'0'1});
+
+    REQUIRE(format_to<format_style::text>(buffer, registers) == "0x1: icc=3 en_ntc=0 ipre=2; 0x1a: 3=1 4=0 5=1");
+    REQUIRE(format_to<format_style::json>(buffer, registers)
+            == R"({"0x1":{"icc":3,"en_ntc":0,"ipre":2},"0x1a":{"3":1,"4":0,"5":1}})");
+    REQUIRE(format_to<format_style::csv>(buffer, registers) == "3,0,2,1,0,1");
+
+    auto [end, error] = format_header<register_file<Map>>(std::begin(buffer), std::end(buffer));
+    REQUIRE(error == std::errc{});
+    REQUIRE(std::string_view(buffer, static_cast<std::size_t>(end - buffer))
+            == "0x1.icc,0x1.en_ntc,0x1.ipre,0x1a.3,0x1a.4,0x1a.5");
+
+    SECTION("Negative addresses are written as their unsigned bit patterns")
+    {
+        register_file<small_map<element<int8_t{-5}, ChargeControl>>> negative;
+        negative.load<int8_t{-5}>(ChargeControl{0b00011'0'10});
+
+        REQUIRE(format_to<format_style::text>(buffer, negative) == "0xfb: icc=3 en_ntc=0 ipre=2");
+    }
+}
@@ -0,0 +1,145 @@
+/**
+ * @file	frame.cpp
+ * @brief	Tests decoding and encoding of frames composed of registers, in place within byte buffers.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/frame.hpp"
+#include "small_register/small_register.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class ipv4
+{
+    version,
+    ihl,
+    dscp,
+    total_length,
+    identification,
+    flags,
+    fragment_offset,
+    ttl,
+    protocol,
+    checksum,
+    address
+};
+
+using VersionAndLength = small_register<uint32_t,
+                                        bitfield<ipv4::version, 4>,
+                                        bitfield<ipv4::ihl, 4>,
+                                        bitfield<ipv4::dscp, 8>,
+                                        bitfield<ipv4::total_length, 16>>;
+using Fragmentation = small_register<uint32_t,
+                                     bitfield<ipv4::identification, 16>,
+                                     bitfield<ipv4::flags, 3>,
+                                     bitfield<ipv4::fragment_offset, 13>>;
+using TtlAndProtocol = small_register<uint16_t, bitfield<ipv4::ttl, 8>, bitfield<ipv4::protocol, 8>>;
+using Checksum = small_register<uint16_t, bitfield<ipv4::checksum, 16>>;
+using Address = small_register<uint32_t, bitfield<ipv4::address, 32>>;
+
+using Ipv4 = frame<VersionAndLength, Fragmentation, TtlAndProtocol, Checksum>;
+
+// clang-format off
+constexpr std::array<uint8_t, 12> header{
+    0x45, 0x00, 0x00, 0x54,
+    0xAB, 0xCD, 0x40, 0x00,
+    0x40, 0x11,
+    0x12, 0x34};
+// clang-format on
+
+} // namespace
+
+TEST_CASE("Frames are decoded in place", "[frame]")
+{
+    static_assert(Ipv4::size == 12);
+    static_assert(Ipv4::offset<2> == 8);
+
+    auto h{Ipv4::make_view(header.data())};
+
+    SECTION("Bitfields are accessed by IDs")
+    {
+        REQUIRE(h.get<ipv4::version>() == 4);
+        REQUIRE(h.get<ipv4::ihl>() == 5);
+        REQUIRE(h.get<ipv4::total_length>() == 84);
+        REQUIRE(h.get<ipv4::identification>() == 0xABCD);
+        REQUIRE(h.get<ipv4::flags>() == 0b010);
+        REQUIRE(h.get<ipv4::ttl>() == 64);
+        REQUIRE(h.get<ipv4::protocol>() == 17);
+        REQUIRE(h.get<ipv4::checksum>() == 0x1234);
+    }
+
+    SECTION("Registers are accessed by indices")
+    {
+        REQUIRE(h.load<0>()() == 0x4500'0054);
+        REQUIRE(h.load<3>()() == 0x1234);
+    }
+
+    SECTION("All the registers are decoded at once")
+    {
+        auto [version_and_length, fragmentation, ttl_and_protocol, checksum] = Ipv4::decode(header.data());
+        REQUIRE(version_and_length.get<ipv4::dscp>() == 0);
+        REQUIRE(fragmentation.get<ipv4::fragment_offset>() == 0);
+        REQUIRE(ttl_and_protocol() == 0x4011);
+        REQUIRE(checksum() == 0x1234);
+    }
+}
+
+TEST_CASE("Frames are modified and encoded in place", "[frame]")
+{
+    auto buffer{header};
+    auto h{Ipv4::make_view(buffer.data())};
+
+    SECTION("Bitfields are modified by IDs")
+    {
+        h.assign<ipv4::ttl>(h.get<ipv4::ttl>() - 1).clear<ipv4::checksum>().set<ipv4::dscp>(0x2E);
+        REQUIRE(buffer == std::array<uint8_t, 12>{0x45, 0x2E, 0x00, 0x54, 0xAB, 0xCD, 0x40, 0x00, 0x3F, 0x11, 0x00, 0x00});
+    }
+
+    SECTION("Overflow is reported as by the register")
+    {
+        REQUIRE_THROWS_AS(h.assign<ipv4::ihl>(16), VersionAndLength::overflow_error);
+        REQUIRE(buffer == header);
+    }
+
+    SECTION("Registers are encoded")
+    {
+        std::array<std::byte, Ipv4::size> out{};
+        Ipv4::encode(out.data(),
+                     VersionAndLength{0x4500'0054},
+                     Fragmentation{0xABCD'4000},
+                     TtlAndProtocol{0x4011},
+                     Checksum{0x1234});
+        REQUIRE(std::memcmp(out.data(), header.data(), Ipv4::size) == 0);
+    }
+}
+
+TEST_CASE("Back-to-back frames are iterated", "[frame]")
+{
+    using Addresses = frame<Address, Address>;
+
+    std::vector<uint8_t> received{0x0A, 0x00, 0x00, 0x01, 0xC0, 0xA8, 0x00, 0x01, 0x0A, 0x00, 0x00, 0x02, 0xC0, 0xA8,
+                                  0x00, 0x02, 0x0A, 0x00};
+
+    auto frames{Addresses::frames(received.data(), received.size())};
+    REQUIRE(frames.frame_count() == 2);
+    REQUIRE(frames.remainder() == 2);
+
+    std::vector<uint32_t> sources;
+    for (auto f : frames)
+    {
+        sources.push_back(f.load<0>()());
+        f.store<1>(Address{0});
+    }
+    REQUIRE(sources == std::vector<uint32_t>{0x0A00'0001, 0x0A00'0002});
+    REQUIRE(received[4] == 0x00);
+    REQUIRE(received[12] == 0x00);
+}
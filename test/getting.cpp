@@ -82,4 +82,13 @@ TEST_CASE("Individual bitfields are obtained", "[small_register][get]")
             REQUIRE(reg.get<reg::three>() == 0b010);
         }
     }
+
+    SECTION("For bitfields of 32 bits and more")
+    {
+        auto reg{small_register<uint64_t, bitfield<reg::one, 32>, bitfield<reg::two, 32>>{0x89ABCDEF01234567}};
+
+        REQUIRE(reg.get<reg::one>() == 0x89ABCDEF);
+        REQUIRE(reg.get<reg::two>() == 0x01234567);
+        REQUIRE(small_register<uint64_t, bitfield<reg::one, 64>>{~uint64_t{0}}.get<reg::one>() == ~uint64_t{0});
+    }
 }
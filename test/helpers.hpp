@@ -6,6 +6,8 @@
 #ifndef HELPERS_HPP
 #define HELPERS_HPP
 
+#include <cstdint>
+
 enum class reg
 {
     one,
@@ -18,4 +20,34 @@ enum class reg
     eight
 };
 
+//! Access policy of jungles::mmio_register which counts the volatile accesses and remembers the last stored value.
+struct counting_access
+{
+    static inline unsigned loads{0};
+    static inline unsigned stores{0};
+    static inline std::uint64_t stored{0};
+
+    static void reset()
+    {
+        loads = 0;
+        stores = 0;
+        stored = 0;
+    }
+
+    template<typename T>
+    static T load(const volatile T* address)
+    {
+        ++loads;
+        return *address;
+    }
+
+    template<typename T>
+    static void store(volatile T* address, T value)
+    {
+        ++stores;
+        stored = value;
+        *address = value;
+    }
+};
+
 #endif /* HELPERS_HPP */
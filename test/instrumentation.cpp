@@ -0,0 +1,214 @@
+/**
+ * @file	instrumentation.cpp
+ * @brief	Tests counting and tracing the operations on the bitfields of the jungles::instrumented registers.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/atomic_small_register.hpp"
+#include "small_register/deferred.hpp"
+#include "small_register/field_counters.hpp"
+#include "small_register/mmio_register.hpp"
+#include "small_register/memory_transport.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+template<typename Policy>
+using Reg = basic_small_register<Policy, uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 3>, bitfield<reg::three, 3>>;
+
+using Counted = Reg<instrumented<overflow::truncate, field_counters<>>>;
+
+struct recorded
+{
+    unsigned position;
+    access operation;
+
+    bool operator==(const recorded& other) const
+    {
+        return position == other.position && operation == other.operation;
+    }
+};
+
+std::vector<recorded> trace_log;
+
+//! The counts as reads, sets, clears, assigns and overflows, to be compared at once.
+auto as_tuple(const field_counts& counts)
+{
+    return std::tuple{counts.reads, counts.sets, counts.clears, counts.assigns, counts.overflows};
+}
+
+using counts_tuple = std::tuple<std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t>;
+
+struct logging_tracer
+{
+    template<typename Register, auto Id>
+    static void record(access operation)
+    {
+        trace_log.push_back({static_cast<unsigned>(Register::template position<Id>()), operation});
+    }
+};
+
+} // namespace
+
+TEST_CASE("Operations on the bitfields are counted", "[instrumentation]")
+{
+    field_counters<>::reset<Counted>();
+    Counted r;
+
+    r.set<reg::one>().set<reg::two>(0b101).assign<reg::three>(0b1111);
+    r.clear<reg::one, reg::two>();
+    r.get<reg::two>();
+    auto [one, three] = r.get<reg::one, reg::three>();
+    (void)one;
+    (void)three;
+
+    auto counts{field_counters<>::snapshot<Counted>()};
+    REQUIRE(counts.size() == 3);
+
+    REQUIRE(counts[0].sets == 1);
+    REQUIRE(counts[0].clears == 1);
+    REQUIRE(counts[0].reads == 1);
+    REQUIRE(counts[0].overflows == 0);
+
+    REQUIRE(counts[1].sets == 1);
+    REQUIRE(counts[1].clears == 1);
+    REQUIRE(counts[1].reads == 1);
+
+    REQUIRE(counts[2].assigns == 1);
+    REQUIRE(counts[2].overflows == 1);
+    REQUIRE(counts[2].reads == 1);
+    REQUIRE(counts[2].sets == 0);
+
+    SECTION("Counters of a single bitfield are exported")
+    {
+        auto three_counts{field_counters<>::snapshot<Counted, reg::three>()};
+        REQUIRE(three_counts.assigns == 1);
+        REQUIRE(three_counts.overflows == 1);
+    }
+
+    SECTION("Counters are reset")
+    {
+        field_counters<>::reset<Counted>();
+        auto after_reset{field_counters<>::snapshot<Counted, reg::three>()};
+        REQUIRE(after_reset.assigns == 0);
+        REQUIRE(after_reset.overflows == 0);
+    }
+}
+
+TEST_CASE("Operations on atomic and deferred registers are counted once, as the operations performed",
+          "[instrumentation]")
+{
+    field_counters<>::reset<Counted>();
+
+    SECTION("Atomic registers")
+    {
+        atomic_small_register<Counted> r;
+        r.assign<reg::three>(3);
+        r.set<reg::one>();
+        r.clear<reg::two>(0b001);
+    }
+
+    SECTION("Deferred chains")
+    {
+        Counted r;
+        defer(r).assign<reg::three>(3).set<reg::one>().clear<reg::two>(0b001);
+    }
+
+    REQUIRE(as_tuple(field_counters<>::snapshot<Counted, reg::one>()) == counts_tuple{0, 1, 0, 0, 0});
+    REQUIRE(as_tuple(field_counters<>::snapshot<Counted, reg::two>()) == counts_tuple{0, 0, 1, 0, 0});
+    REQUIRE(as_tuple(field_counters<>::snapshot<Counted, reg::three>()) == counts_tuple{0, 0, 0, 1, 0});
+}
+
+TEST_CASE("Clears through the clear alias are counted as clears of the register", "[instrumentation]")
+{
+    field_counters<>::reset<Counted>();
+    volatile uint8_t memory[2]{0xFF, 0x00};
+    mmio_register<Counted> r{&memory[0], nullptr, &memory[1]};
+
+    r.clear_only<reg::one, reg::three>();
+    r.clear_only<reg::two>(0b1001);
+
+    REQUIRE(memory[1] == 0b0000'1000);
+    REQUIRE(as_tuple(field_counters<>::snapshot<Counted, reg::one>()) == counts_tuple{0, 0, 1, 0, 0});
+    REQUIRE(as_tuple(field_counters<>::snapshot<Counted, reg::two>()) == counts_tuple{0, 0, 1, 0, 1});
+    REQUIRE(as_tuple(field_counters<>::snapshot<Counted, reg::three>()) == counts_tuple{0, 0, 1, 0, 0});
+}
+
+TEST_CASE("Per-thread counters count only the operations of the calling thread", "[instrumentation]")
+{
+    using Counters = field_counters<counting::per_thread>;
+    using PerThread = Reg<instrumented<overflow::throw_error, Counters>>;
+
+    PerThread r;
+    r.set<reg::one>();
+    std::thread{[]() {
+        PerThread other;
+        other.set<reg::one>().set<reg::one>();
+        REQUIRE(Counters::snapshot<PerThread, reg::one>().sets == 2);
+    }}.join();
+
+    REQUIRE(Counters::snapshot<PerThread, reg::one>().sets == 1);
+}
+
+TEST_CASE("Operations on the bitfields are forwarded to a user tracer", "[instrumentation]")
+{
+    using Traced = Reg<instrumented<overflow::return_error, logging_tracer>>;
+    trace_log.clear();
+
+    Traced r;
+    REQUIRE(r.set<reg::two>(0b1000) == std::errc::value_too_large);
+    r.clear<reg::three, 0b1>().set_from<reg::one>(7);
+
+    REQUIRE(trace_log
+            == std::vector<recorded>{{1, access::set},
+                                     {1, access::overflow},
+                                     {2, access::clear},
+                                     {0, access::assign},
+                                     {0, access::overflow}});
+
+    SECTION("Reads of the bitfields with the IDs known only at runtime are traced, except the unknown IDs")
+    {
+        trace_log.clear();
+        r.get(reg::three);
+        r.get(reg::four);
+
+        REQUIRE(trace_log == std::vector<recorded>{{2, access::read}});
+    }
+}
+
+TEST_CASE("Transfers of the instrumented registers of a map are counted per address", "[instrumentation]")
+{
+    using Map = small_map<element<0x00, Counted>, element<0x01, Reg<overflow::throw_error>>, element<0x02, Counted>>;
+    field_counters<>::reset<Map>();
+    memory_transport<4> bus;
+
+    Map::read<0x00, 0x01, 0x02>(bus);
+    Map::read<0x02>(bus);
+    Map::write<0x00>(bus, Counted{0x12});
+
+    auto counts{field_counters<>::snapshot<Map>()};
+    REQUIRE(counts[0].reads == 1);
+    REQUIRE(counts[0].assigns == 1);
+    REQUIRE(counts[1].reads == 0);
+    REQUIRE(counts[2].reads == 2);
+    REQUIRE(counts[2].assigns == 0);
+}
+
+TEST_CASE("Registers without a tracer behave as with the bare policy", "[instrumentation]")
+{
+    using Disabled = Reg<instrumented<overflow::saturate, void>>;
+    static_assert(Disabled{}.set<reg::two>(0b1111).get<reg::two>() == 0b111);
+    static_assert(sizeof(Disabled) == sizeof(uint8_t));
+}
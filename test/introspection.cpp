@@ -0,0 +1,72 @@
+/**
+ * @file	introspection.cpp
+ * @brief	Tests the runtime descriptors of the bitfields, the iteration over the bitfields and the access by runtime ID.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg = small_register<uint16_t, bitfield<reg::three, 3>, bitfield<reg::one, 9>, bitfield<reg::five, 4>>;
+
+// IDs far apart, for which a perfect hash table is generated.
+using Sparse = small_register<uint8_t, bitfield<1000u, 2>, bitfield<7u, 2>, bitfield<123456u, 4>>;
+
+} // namespace
+
+TEST_CASE("Bitfields are described at runtime", "[introspection]")
+{
+    static_assert(Reg::fields.size() == 3);
+    static_assert(Reg::fields[1].id == reg::one);
+    static_assert(Reg::fields[1].shift == 4);
+    static_assert(Reg::fields[1].width == 9);
+    static_assert(Reg::fields[1].mask == 0x1FF);
+
+    REQUIRE(Reg::find_field(reg::five) == &Reg::fields[2]);
+    REQUIRE(Reg::find_field(reg::two) == nullptr);
+}
+
+TEST_CASE("Bitfields are read with IDs known at runtime", "[introspection]")
+{
+    Reg r{0b101'110011001'0110};
+
+    REQUIRE(r.get(reg::three) == 0b101);
+    REQUIRE(r.get(reg::one) == 0b110011001);
+    REQUIRE(r.get(reg::five) == 0b0110);
+
+    SECTION("Unknown IDs give zero")
+    {
+        REQUIRE(r.get(reg::two) == 0);
+        REQUIRE(r.get(reg::eight) == 0);
+    }
+
+    SECTION("Sparse IDs are found")
+    {
+        Sparse sparse{0b01'10'1111};
+        REQUIRE(sparse.get(1000u) == 0b01);
+        REQUIRE(sparse.get(7u) == 0b10);
+        REQUIRE(sparse.get(123456u) == 0b1111);
+        REQUIRE(sparse.get(8u) == 0);
+    }
+}
+
+TEST_CASE("All the bitfields are visited in the order of declaration", "[introspection]")
+{
+    Reg r{0b101'110011001'0110};
+    std::vector<std::pair<reg, uint16_t>> visited;
+
+    r.for_each_field([&](auto id, auto value) { visited.emplace_back(decltype(id)::value, value); });
+
+    REQUIRE(visited
+            == std::vector<std::pair<reg, uint16_t>>{{reg::three, 0b101}, {reg::one, 0b110011001}, {reg::five, 0b0110}});
+}
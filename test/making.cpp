@@ -0,0 +1,52 @@
+/**
+ * @file	making.cpp
+ * @brief	Tests building the registers from the values of the bitfields known at compile time.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg = small_register<uint16_t, bitfield<reg::one, 4>, bitfield<reg::two, 1>, bitfield<reg::three, 11>>;
+
+static constexpr std::array<uint16_t, 3> init_sequence{
+    make<Reg>(field<reg::one, 0xA>)(),
+    make<Reg>(field<reg::two, 1>, field<reg::three, 0x123>)(),
+    make<Reg>()(),
+};
+
+} // namespace
+
+TEST_CASE("Registers are built at compile time", "[make]")
+{
+    SECTION("Values are placed in the bitfields")
+    {
+        constexpr auto r{make<Reg>(field<reg::three, 0x7FF>, field<reg::one, 0b1001>, field<reg::two, 0>)};
+        static_assert(std::is_same_v<decltype(r), const Reg>);
+        static_assert(r() == 0b1001'0'11111111111);
+        REQUIRE(r.get<reg::one>() == 0b1001);
+        REQUIRE(r.get<reg::three>() == 0x7FF);
+    }
+
+    SECTION("Raw values are usable as template arguments and in constant tables")
+    {
+        static_assert(std::integral_constant<uint16_t, make<Reg>(field<reg::two, 1>)()>::value == 0x0800);
+        REQUIRE(init_sequence == std::array<uint16_t, 3>{0xA000, 0x0923, 0});
+    }
+
+    SECTION("Result doesn't depend on the overflow policy")
+    {
+        using Unchecked = Reg::with_policy<overflow::unchecked>;
+        static_assert(make<Unchecked>(field<reg::one, 3>)() == make<Reg>(field<reg::one, 3>)());
+    }
+}
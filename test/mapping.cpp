@@ -45,4 +45,34 @@ TEST_CASE("Mapping of registers can be performed", "[small_register][small_map]"
         REQUIRE(std::is_same_v<MemoryMap::register_from_address<0x01>::type, Reg1>);
         REQUIRE(std::is_same_v<MemoryMap::register_from_address<0x02>::type, Reg2>);
     }
+
+    SECTION("Addresses can be declared in any order")
+    {
+        using Reg1 = small_register<uint8_t, bitfield<reg1::bitfield1, 8>>;
+        using Reg2 = small_register<uint16_t, bitfield<reg1::bitfield1, 16>>;
+        using Reg3 = small_register<uint32_t, bitfield<reg1::bitfield1, 32>>;
+
+        using MemoryMap = small_map<element<0x30, Reg1>, element<0x10, Reg2>, element<0x20, Reg3>>;
+
+        REQUIRE(std::is_same_v<MemoryMap::register_from_address<0x30>::type, Reg1>);
+        REQUIRE(std::is_same_v<MemoryMap::register_from_address<0x10>::type, Reg2>);
+        REQUIRE(std::is_same_v<MemoryMap::register_from_address<0x20>::type, Reg3>);
+        REQUIRE(MemoryMap::register_from_address<0x30>::index == 0);
+        REQUIRE(MemoryMap::register_from_address<0x10>::index == 1);
+        REQUIRE(MemoryMap::register_from_address<0x20>::index == 2);
+    }
+
+    SECTION("Addresses can be of another integral type than the declared ones")
+    {
+        using Reg1 = small_register<uint8_t, bitfield<reg1::bitfield1, 8>>;
+        using Reg2 = small_register<uint16_t, bitfield<reg1::bitfield1, 16>>;
+
+        using MemoryMap = small_map<element<0x01, Reg1>, element<0x02, Reg2>>;
+
+        REQUIRE(std::is_same_v<MemoryMap::register_from_address<0x01u>::type, Reg1>);
+        REQUIRE(std::is_same_v<MemoryMap::register_from_address<uint8_t{0x02}>::type, Reg2>);
+        REQUIRE(MemoryMap::position<0x02ull>() == 1);
+        REQUIRE(detail::lookup(detail::make_sorted_index(std::array<uint8_t, 2>{0x01, 0x02}), 0x101u) == 2);
+        REQUIRE(detail::lookup(detail::make_sorted_index(std::array{0x01, 0x02}), 0x1'0000'0001ll) == 2);
+    }
 }
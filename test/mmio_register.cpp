@@ -0,0 +1,131 @@
+/**
+ * @file	mmio_register.cpp
+ * @brief	Tests the memory-mapped register, backed by an anonymous mmap() region, counting the volatile accesses.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/mmio_register.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <system_error>
+
+#include <sys/mman.h>
+
+using namespace jungles;
+
+namespace
+{
+
+//! Emulates a peripheral window: a register followed by its set and clear aliases.
+struct mapped_window
+{
+    mapped_window()
+    {
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        REQUIRE(memory != MAP_FAILED);
+    }
+
+    ~mapped_window()
+    {
+        munmap(memory, size);
+    }
+
+    volatile uint32_t* word(std::size_t index)
+    {
+        return static_cast<volatile uint32_t*>(memory) + index;
+    }
+
+    static constexpr std::size_t size{4096};
+    void* memory;
+};
+
+using Control = small_register<uint32_t, bitfield<reg::one, 8>, bitfield<reg::two, 16>, bitfield<reg::three, 8>>;
+
+// Interrupt status with a clear alias: the flags and the read-only state are cleared by writing ones to the alias.
+using Status = small_register<uint32_t,
+                              write_1_to_clear<bitfield<reg::one, 8>>,
+                              read_only<bitfield<reg::two, 16>>,
+                              bitfield<reg::three, 8>>;
+
+} // namespace
+
+TEST_CASE("Memory-mapped registers are accessed once per operation", "[mmio_register]")
+{
+    mapped_window window;
+    *window.word(0) = 0x11223344;
+    counting_access::reset();
+
+    mmio_register<Control, counting_access> control{window.word(0), window.word(1), window.word(2)};
+
+    SECTION("Reading performs one load")
+    {
+        REQUIRE(control.get<reg::one, reg::three>() == std::tuple{0x11u, 0x44u});
+        REQUIRE(counting_access::loads == 1);
+        REQUIRE(counting_access::stores == 0);
+    }
+
+    SECTION("Merged operations perform one load and one store")
+    {
+        control.assign<reg::one, reg::two>(0xAA, 0xBBCC);
+        REQUIRE(*window.word(0) == 0xAABBCC44);
+
+        control.clear<reg::one, reg::three>();
+        REQUIRE(*window.word(0) == 0x00BBCC00);
+
+        control.modify([](auto& r) { r.template set<reg::one>(0x01).template clear<reg::two>(); });
+        REQUIRE(*window.word(0) == 0x01000000);
+
+        REQUIRE(counting_access::loads == 3);
+        REQUIRE(counting_access::stores == 3);
+    }
+
+    SECTION("Writing performs one store")
+    {
+        control.write(Control{0xCAFEBABE});
+        REQUIRE(*window.word(0) == 0xCAFEBABE);
+        REQUIRE(counting_access::loads == 0);
+        REQUIRE(counting_access::stores == 1);
+    }
+
+    SECTION("Set and clear aliases are written without loading the register")
+    {
+        control.set_only<reg::two>(0x0101);
+        control.clear_only<reg::one, reg::three>();
+
+        REQUIRE(*window.word(0) == 0x11223344);
+        REQUIRE(*window.word(1) == 0x00010100);
+        REQUIRE(*window.word(2) == 0xFF0000FF);
+        REQUIRE(counting_access::loads == 0);
+        REQUIRE(counting_access::stores == 2);
+    }
+
+    SECTION("Write-1-to-clear and read-only bitfields are cleared through the clear alias")
+    {
+        mmio_register<Status, counting_access> status{window.word(0), nullptr, window.word(2)};
+        status.clear_only<reg::one>();
+        REQUIRE(*window.word(2) == 0xFF000000);
+
+        status.clear_only<reg::two>(0x8001);
+        REQUIRE(*window.word(2) == 0x00800100);
+
+        REQUIRE(*window.word(0) == 0x11223344);
+        REQUIRE(counting_access::loads == 0);
+        REQUIRE(counting_access::stores == 2);
+    }
+
+    SECTION("Nothing is stored on error")
+    {
+        mmio_register<Control::with_policy<overflow::return_error>, counting_access> checked{window.word(0),
+                                                                                              window.word(1)};
+
+        REQUIRE(checked.assign<reg::one>(0x100) == std::errc::value_too_large);
+        REQUIRE(checked.set_only<reg::one>(0x100) == std::errc::value_too_large);
+        REQUIRE_THROWS_AS(control.set<reg::one>(0x100), Control::overflow_error);
+
+        REQUIRE(*window.word(0) == 0x11223344);
+        REQUIRE(counting_access::stores == 0);
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file	multi_field.cpp
+ * @brief	Tests operations that access multiple bitfields at once.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+TEST_CASE("Multiple bitfields are accessed at once", "[small_register][multi]")
+{
+    using RegisterUnderTest =
+        small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 3>, bitfield<reg::three, 3>>;
+
+    SECTION("Bitfields are set")
+    {
+        RegisterUnderTest reg{0b01000001};
+
+        SECTION("Explicitly")
+        {
+            REQUIRE(reg.set<reg::one, reg::three>(0b10, 0b100)() == 0b11000101);
+        }
+
+        SECTION("Implicitly")
+        {
+            REQUIRE(reg.set<reg::two, reg::three>()() == 0b01111111);
+        }
+
+        SECTION("Overflow of any value is detected")
+        {
+            REQUIRE_THROWS_AS((reg.set<reg::one, reg::three>(0b100, 0b111)), RegisterUnderTest::overflow_error);
+            REQUIRE_THROWS_AS((reg.set<reg::one, reg::three>(0b11, 0b1000)), RegisterUnderTest::overflow_error);
+            REQUIRE(reg() == 0b01000001);
+        }
+    }
+
+    SECTION("Bitfields are cleared")
+    {
+        RegisterUnderTest reg{0xFF};
+
+        SECTION("Explicitly")
+        {
+            REQUIRE(reg.clear<reg::one, reg::three>(0b01, 0b101)() == 0b10111010);
+        }
+
+        SECTION("Implicitly")
+        {
+            REQUIRE(reg.clear<reg::one, reg::two>()() == 0b00000111);
+        }
+
+        SECTION("Mismatching mask is detected")
+        {
+            REQUIRE_THROWS_AS((reg.clear<reg::two, reg::three>(0b111, 0b1000)),
+                              RegisterUnderTest::mask_not_matching_error);
+            REQUIRE(reg() == 0xFF);
+        }
+    }
+
+    SECTION("Bitfields are assigned")
+    {
+        RegisterUnderTest reg{0b10110110};
+
+        SECTION("Single bitfield")
+        {
+            REQUIRE(reg.assign<reg::two>(0b001)() == 0b10001110);
+        }
+
+        SECTION("Multiple bitfields, leaving the others unchanged")
+        {
+            REQUIRE(reg.assign<reg::three, reg::one>(0b001, 0b01)() == 0b01110001);
+        }
+
+        SECTION("Is equivalent to clear and set chain")
+        {
+            RegisterUnderTest chained{reg()};
+            chained.clear<reg::one>().set<reg::one>(0b11).clear<reg::two>().set<reg::two>(0b010);
+            REQUIRE(reg.assign<reg::one, reg::two>(0b11, 0b010)() == chained());
+        }
+
+        SECTION("Overflow is detected and the register is left unchanged")
+        {
+            REQUIRE_THROWS_AS((reg.assign<reg::one, reg::two>(0b11, 0b1000)), RegisterUnderTest::overflow_error);
+            REQUIRE(reg() == 0b10110110);
+        }
+    }
+
+    SECTION("Bitfields are obtained as a tuple")
+    {
+        const RegisterUnderTest reg{0b10110110};
+
+        auto [three, one] = reg.get<reg::three, reg::one>();
+        REQUIRE(three == 0b110);
+        REQUIRE(one == 0b10);
+
+        REQUIRE(reg.get<reg::one, reg::two, reg::three>() == std::tuple<uint8_t, uint8_t, uint8_t>{0b10, 0b110, 0b110});
+    }
+
+    SECTION("Are usable in constant expressions")
+    {
+        constexpr auto value{RegisterUnderTest{}.assign<reg::one, reg::three>(0b01, 0b011)()};
+        static_assert(value == 0b01000011);
+        REQUIRE(value == 0b01000011);
+    }
+}
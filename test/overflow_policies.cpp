@@ -0,0 +1,115 @@
+/**
+ * @file	overflow_policies.cpp
+ * @brief	Tests the policies of handling values which don't fit the bitfields.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+using namespace jungles;
+
+namespace
+{
+
+template<typename Policy>
+using RegisterWithPolicy = basic_small_register<Policy,
+                                                uint8_t,
+                                                bitfield<reg::one, 2>,
+                                                bitfield<reg::two, 3>,
+                                                bitfield<reg::three, 3>>;
+
+} // namespace
+
+TEST_CASE("Values not fitting the bitfields are handled according to the policy", "[small_register][policy]")
+{
+    SECTION("Throwing is the default policy")
+    {
+        using RegisterUnderTest = small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 6>>;
+        REQUIRE(std::is_same_v<RegisterUnderTest::overflow_policy, overflow::throw_error>);
+        REQUIRE(std::is_same_v<RegisterUnderTest::with_policy<overflow::throw_error>, RegisterUnderTest>);
+    }
+
+    SECTION("Error is returned")
+    {
+        RegisterWithPolicy<overflow::return_error> reg{0b01000001};
+
+        SECTION("When value fits")
+        {
+            REQUIRE(reg.set<reg::two>(0b101) == std::errc{});
+            REQUIRE(reg() == 0b01101001);
+        }
+
+        SECTION("On overflow, leaving the register unchanged")
+        {
+            REQUIRE(reg.set<reg::two>(0b1000) == std::errc::value_too_large);
+            REQUIRE(reg.assign<reg::one, reg::three>(0b11, 0b1000) == std::errc::value_too_large);
+            REQUIRE(reg() == 0b01000001);
+        }
+
+        SECTION("On mask not matching, leaving the register unchanged")
+        {
+            REQUIRE(reg.clear<reg::three>(0b1001) == std::errc::invalid_argument);
+            REQUIRE(reg() == 0b01000001);
+        }
+
+        SECTION("Operations without runtime values can still be chained")
+        {
+            REQUIRE(reg.clear<reg::one>().set<reg::three>()() == 0b00000111);
+        }
+    }
+
+    SECTION("Value is truncated")
+    {
+        RegisterWithPolicy<overflow::truncate> reg{};
+
+        REQUIRE(reg.set<reg::two>(0b11010)() == 0b00010000);
+        REQUIRE(reg.assign<reg::two, reg::three>(0b1111, 0b1001)() == 0b00111001);
+        REQUIRE(reg.clear<reg::two>(0b11101)() == 0b00010001);
+    }
+
+    SECTION("Value is saturated")
+    {
+        RegisterWithPolicy<overflow::saturate> reg{};
+
+        REQUIRE(reg.set<reg::two>(0b1000)() == 0b00111000);
+        REQUIRE(reg.assign<reg::one, reg::two>(0b1000, 0b010)() == 0b11010000);
+        REQUIRE(reg.clear<reg::one>(0b100)() == 0b00010000);
+    }
+
+    SECTION("Value is not checked")
+    {
+        RegisterWithPolicy<overflow::unchecked> reg{};
+
+        REQUIRE(reg.set<reg::two>(0b101)() == 0b00101000);
+        REQUIRE(reg.assign<reg::one, reg::three>(0b10, 0b011)() == 0b10101011);
+    }
+}
+
+TEST_CASE("Values known at compile time are checked at compile time", "[small_register][policy]")
+{
+    using RegisterUnderTest = RegisterWithPolicy<overflow::throw_error>;
+
+    SECTION("Value is set")
+    {
+        REQUIRE(RegisterUnderTest{0b01000000}.set<reg::three, 0b101>()() == 0b01000101);
+    }
+
+    SECTION("Value is assigned")
+    {
+        REQUIRE(RegisterUnderTest{0b01111111}.assign<reg::two, 0b010>()() == 0b01010111);
+    }
+
+    SECTION("Mask is cleared")
+    {
+        REQUIRE(RegisterUnderTest{0xFF}.clear<reg::one, 0b01>()() == 0b10111111);
+    }
+
+    SECTION("Regardless of the policy")
+    {
+        constexpr auto value{RegisterWithPolicy<overflow::return_error>{}.set<reg::one, 0b11>().assign<reg::three, 1>()};
+        static_assert(value() == 0b11000001);
+        REQUIRE(value() == 0b11000001);
+    }
+}
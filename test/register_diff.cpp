@@ -0,0 +1,90 @@
+/**
+ * @file	register_diff.cpp
+ * @brief	Tests detecting the bitfields changed between register snapshots and dispatching the changes to handlers.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/register_diff.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Status = small_register<uint16_t,
+                              bitfield<reg::one, 1>,
+                              bitfield<reg::two, 3>,
+                              bitfield<reg::three, 8>,
+                              bitfield<reg::four, 4>>;
+
+} // namespace
+
+TEST_CASE("Changed bitfields are detected", "[register_diff]")
+{
+    Status previous{0b1'010'00001111'0011};
+
+    SECTION("Nothing changes")
+    {
+        auto changes{diff(previous, previous)};
+        REQUIRE_FALSE(changes);
+        REQUIRE_FALSE(changes.changed<reg::one>());
+        REQUIRE(changes.bits() == 0);
+    }
+
+    SECTION("Single bit of a multi-bit bitfield changes")
+    {
+        Status current{0b1'010'00001011'0011};
+        auto changes{diff(previous, current)};
+        REQUIRE(changes.any());
+        REQUIRE(changes.changed<reg::three>());
+        REQUIRE_FALSE(changes.changed<reg::one>());
+        REQUIRE_FALSE(changes.changed<reg::two>());
+        REQUIRE_FALSE(changes.changed<reg::four>());
+    }
+
+    SECTION("Changed bitfields are visited, from the last one")
+    {
+        Status current{0b0'010'10001111'0010};
+        std::vector<reg> visited;
+        diff(previous, current).for_each_changed([&](auto id) { visited.push_back(decltype(id)::value); });
+        REQUIRE(visited == std::vector<reg>{reg::four, reg::three, reg::one});
+    }
+}
+
+TEST_CASE("Changes are dispatched to the bitfield handlers", "[register_diff]")
+{
+    std::vector<std::pair<unsigned, unsigned>> two_changes;
+    std::vector<std::pair<unsigned, unsigned>> four_changes;
+
+    auto dispatch{make_dispatcher<Status>(
+        on<reg::two>([&](auto old_value, auto new_value) { two_changes.emplace_back(old_value, new_value); }),
+        on<reg::four>([&](auto old_value, auto new_value) { four_changes.emplace_back(old_value, new_value); }))};
+
+    SECTION("Only the handlers of the changed bitfields are called")
+    {
+        REQUIRE(dispatch(Status{0b0'010'00000000'0011}, Status{0b0'010'00000000'1100}));
+        REQUIRE(two_changes.empty());
+        REQUIRE(four_changes == std::vector<std::pair<unsigned, unsigned>>{{0b0011, 0b1100}});
+    }
+
+    SECTION("Changes of the bitfields without handlers are ignored")
+    {
+        REQUIRE_FALSE(dispatch(Status{0b0'010'00000000'0000}, Status{0b1'010'11111111'0000}));
+        REQUIRE(two_changes.empty());
+        REQUIRE(four_changes.empty());
+    }
+
+    SECTION("All the handlers are called for all the changes")
+    {
+        REQUIRE(dispatch(Status{0b0'111'00000000'0001}, Status{0b1'000'00000001'0000}));
+        REQUIRE(two_changes == std::vector<std::pair<unsigned, unsigned>>{{0b111, 0b000}});
+        REQUIRE(four_changes == std::vector<std::pair<unsigned, unsigned>>{{0b0001, 0b0000}});
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * @file	register_file.cpp
+ * @brief	Tests the shadow register file, which writes back only the modified registers.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/register_file.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+enum class cc0
+{
+    vin_min,
+    iin_lim
+};
+
+enum class cc1
+{
+    icc,
+    en_ntc,
+    ipre
+};
+
+enum class misc
+{
+    timer,
+    reserved
+};
+
+using ChargeControl0 = small_register<uint8_t, bitfield<cc0::vin_min, 4>, bitfield<cc0::iin_lim, 4>>;
+using ChargeControl1 = small_register<uint8_t, bitfield<cc1::icc, 5>, bitfield<cc1::en_ntc, 1>, bitfield<cc1::ipre, 2>>;
+using Miscellaneous = small_register<uint16_t, bitfield<misc::timer, 12>, bitfield<misc::reserved, 4>>;
+
+using Map = small_map<element<0x00, ChargeControl0>, element<0x01, ChargeControl1>, element<0x07, Miscellaneous>>;
+
+struct recording_bus
+{
+    void write(int address, unsigned value)
+    {
+        writes.emplace_back(address, value);
+    }
+
+    unsigned read(int address)
+    {
+        ++reads;
+        return device[address];
+    }
+
+    std::vector<std::pair<int, unsigned>> writes;
+    std::map<int, unsigned> device;
+    unsigned reads{0};
+};
+
+} // namespace
+
+TEST_CASE("Register file writes back only the modified registers", "[register_file]")
+{
+    register_file<Map> file;
+    recording_bus bus;
+
+    SECTION("Registers are zeroed and not modified initially")
+    {
+        REQUIRE(file.get<0x01>()() == 0);
+        REQUIRE_FALSE(file.is_dirty());
+        REQUIRE(file.flush(bus) == 0);
+        REQUIRE(bus.writes.empty());
+    }
+
+    SECTION("Only the modified register is written")
+    {
+        file.update<0x01>([](auto& r) { r.template assign<cc1::icc>(0b11001); });
+
+        REQUIRE(file.is_dirty<0x01>());
+        REQUIRE_FALSE(file.is_dirty<0x00>());
+        REQUIRE(file.flush(bus) == 1);
+        REQUIRE(bus.writes == std::vector<std::pair<int, unsigned>>{{0x01, 0b11001000}});
+
+        SECTION("And is not written again")
+        {
+            REQUIRE_FALSE(file.is_dirty());
+            REQUIRE(file.flush(bus) == 0);
+            REQUIRE(bus.writes.size() == 1);
+        }
+    }
+
+    SECTION("Registers are written in the order of the map")
+    {
+        file.store<0x07>(Miscellaneous{}.set<misc::timer>(0x123));
+        file.store<0x00>(ChargeControl0{0x5A});
+
+        REQUIRE(file.flush(bus) == 2);
+        REQUIRE(bus.writes == std::vector<std::pair<int, unsigned>>{{0x00, 0x5A}, {0x07, 0x1230}});
+    }
+
+    SECTION("Storing the same value doesn't mark the register as modified")
+    {
+        file.update<0x01>([](auto& r) { r.template clear<cc1::en_ntc>(); });
+        file.store<0x00>(ChargeControl0{});
+
+        REQUIRE_FALSE(file.is_dirty());
+        REQUIRE(file.flush(bus) == 0);
+    }
+
+    SECTION("Registers obtained from the device are not modified")
+    {
+        bus.device = {{0x00, 0x11}, {0x01, 0x22}, {0x07, 0x3344}};
+        file.fetch(bus);
+
+        REQUIRE(bus.reads == 3);
+        REQUIRE(file.get<0x07>()() == 0x3344);
+        REQUIRE(file.get<0x01>().get<cc1::en_ntc>() == 0);
+        REQUIRE_FALSE(file.is_dirty());
+
+        file.load<0x01>(ChargeControl1{0xFF});
+        REQUIRE(file.get<0x01>()() == 0xFF);
+        REQUIRE_FALSE(file.is_dirty());
+    }
+
+    SECTION("All registers are written when marked as modified")
+    {
+        file.mark_dirty();
+        REQUIRE(file.flush(bus) == 3);
+    }
+}
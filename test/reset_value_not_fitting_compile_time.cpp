@@ -0,0 +1,22 @@
+/**
+ * @file	reset_value_not_fitting_compile_time.cpp
+ * @brief	Test for static assertion is triggered when the reset value of a map element doesn't fit the register.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+void reset_value_not_fitting_compile_time()
+{
+    using Reg1 = small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 6>>;
+
+    using MemoryMap = small_map<element<0x01, Reg1, 0x100>>;
+
+    MemoryMap::reset_value<0x01>();
+}
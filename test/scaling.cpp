@@ -0,0 +1,100 @@
+/**
+ * @file	scaling.cpp
+ * @brief	Tests signed and scaled bitfields, converted with get_as() and set_from().
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <system_error>
+
+using namespace jungles;
+
+namespace
+{
+
+// Temperature of 0.5 degree per LSB in two's complement, and a voltage of 20 mV per LSB starting from 3 V.
+using Sensor = small_register<uint16_t,
+                              signed_bitfield<reg::one, 8, std::ratio<1, 2>>,
+                              scaled_bitfield<reg::two, 6, std::ratio<20, 1000>, std::ratio<3>>,
+                              signed_bitfield<reg::three, 2>>;
+
+} // namespace
+
+TEST_CASE("Signed and scaled bitfields are converted", "[scaling]")
+{
+    SECTION("Signed bitfields are sign-extended")
+    {
+        Sensor s{0b11111011'000000'10};
+        REQUIRE(s.get<reg::one>() == 0b11111011);
+        REQUIRE(s.get_as<reg::one, float>() == -2.5f);
+        REQUIRE(s.get_as<reg::one, int>() == -2);
+        REQUIRE(s.get_as<reg::three, int>() == -2);
+        REQUIRE(Sensor{0b01111111'000000'01}.get_as<reg::one, double>() == 63.5);
+        REQUIRE(Sensor{0b10000000'000000'00}.get_as<reg::one, double>() == -64.0);
+    }
+
+    SECTION("Scale and offset are applied")
+    {
+        Sensor s{0b00000000'001010'00};
+        REQUIRE(s.get_as<reg::two, double>() == 3.2);
+        REQUIRE(s.get_as<reg::two, int>() == 3);
+        REQUIRE(s.get_as<reg::two, long>() == 3);
+    }
+
+    SECTION("Values are converted back")
+    {
+        Sensor s{0b00000000'111111'00};
+        s.set_from<reg::one>(-2.5f).set_from<reg::two>(3.21).set_from<reg::three>(1);
+        REQUIRE(s() == 0b11111011'001010'01);
+        s.set_from<reg::one>(-64.2).set_from<reg::two>(3);
+        REQUIRE(s.get<reg::one>() == 0b10000000);
+        REQUIRE(s.get<reg::two>() == 0);
+    }
+
+    SECTION("Values out of range are handled by the policy")
+    {
+        Sensor s;
+        REQUIRE_THROWS_AS(s.set_from<reg::one>(64.0), Sensor::overflow_error);
+        REQUIRE_THROWS_AS(s.set_from<reg::two>(2.98), Sensor::overflow_error);
+        REQUIRE_THROWS_AS(s.set_from<reg::three>(-3), Sensor::overflow_error);
+        REQUIRE(s() == 0);
+
+        Sensor::with_policy<overflow::return_error> returning;
+        REQUIRE(returning.set_from<reg::one>(-64.5) == std::errc::value_too_large);
+        REQUIRE(returning.set_from<reg::one>(-64) == std::errc{});
+
+        Sensor::with_policy<overflow::saturate> saturating;
+        saturating.set_from<reg::one>(100.0).set_from<reg::three>(-5);
+        REQUIRE(saturating.get_as<reg::one, float>() == 63.5f);
+        REQUIRE(saturating.get_as<reg::three, int>() == -2);
+
+        Sensor::with_policy<overflow::truncate> truncating;
+        truncating.set_from<reg::three>(2).set_from<reg::two>(2.98);
+        REQUIRE(truncating.get_as<reg::three, int>() == -2);
+        REQUIRE(truncating.get<reg::two>() == 0b111111);
+    }
+
+    SECTION("Values which aren't finite are out of range")
+    {
+        constexpr auto nan{std::numeric_limits<double>::quiet_NaN()};
+        constexpr auto infinity{std::numeric_limits<float>::infinity()};
+
+        Sensor s;
+        REQUIRE_THROWS_AS(s.set_from<reg::one>(nan), Sensor::overflow_error);
+        REQUIRE_THROWS_AS(s.set_from<reg::two>(-infinity), Sensor::overflow_error);
+
+        Sensor::with_policy<overflow::return_error> returning;
+        REQUIRE(returning.set_from<reg::two>(nan) == std::errc::value_too_large);
+
+        Sensor::with_policy<overflow::saturate> saturating;
+        saturating.set_from<reg::one>(nan).set_from<reg::two>(infinity);
+        REQUIRE(saturating.get_as<reg::one, float>() == 63.5f);
+        REQUIRE(saturating.get<reg::two>() == 0b111111);
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file	visiting.cpp
+ * @brief	Tests the runtime dispatch of raw values to the registers of a small_map, by the register address.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/small_map.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace jungles;
+
+namespace
+{
+
+using Reg8 = small_register<uint8_t, bitfield<reg::one, 3>, bitfield<reg::two, 5>>;
+using Reg16 = small_register<uint16_t, bitfield<reg::three, 4>, bitfield<reg::four, 12>>;
+
+struct recording_visitor
+{
+    void operator()(Reg8 r)
+    {
+        values.push_back(r.get<reg::two>());
+    }
+
+    void operator()(Reg16 r)
+    {
+        values.push_back(r.get<reg::four>());
+    }
+
+    std::vector<unsigned> values;
+};
+
+enum class address : uint16_t
+{
+    control = 0x0100,
+    status = 0x2000,
+    data = 0x8004
+};
+
+} // namespace
+
+TEST_CASE("Registers are dispatched by the runtime address", "[small_map][visit]")
+{
+    SECTION("For dense addresses")
+    {
+        using Map = small_map<element<0x02, Reg8>, element<0x00, Reg16>, element<0x05, Reg8>>;
+        recording_visitor visitor;
+
+        REQUIRE(Map::visit(0x02, 0b10111, visitor));
+        REQUIRE(Map::visit(0x00, 0x1234, visitor));
+        REQUIRE(Map::visit(0x05, 0b00011, visitor));
+
+        REQUIRE(visitor.values == std::vector<unsigned>{0b10111, 0x234, 0b00011});
+    }
+
+    SECTION("For sparse addresses")
+    {
+        using Map = small_map<element<address::control, Reg8>,
+                              element<address::status, Reg16>,
+                              element<address::data, Reg8>>;
+        recording_visitor visitor;
+
+        REQUIRE(Map::visit(address::data, 0b11111, visitor));
+        REQUIRE(Map::visit(address::control, 0b00001, visitor));
+        REQUIRE(Map::visit(address::status, 0xFFFF, visitor));
+
+        REQUIRE(visitor.values == std::vector<unsigned>{0b11111, 0b00001, 0xFFF});
+    }
+
+    SECTION("Unknown addresses are not dispatched")
+    {
+        using DenseMap = small_map<element<0x02, Reg8>, element<0x04, Reg8>>;
+        using SparseMap = small_map<element<0x0010u, Reg8>, element<0x1000u, Reg16>, element<0xFFFF0000u, Reg8>>;
+        recording_visitor visitor;
+
+        REQUIRE_FALSE(DenseMap::visit(0x03, 0, visitor));
+        REQUIRE_FALSE(DenseMap::visit(0x01, 0, visitor));
+        REQUIRE_FALSE(DenseMap::visit(0xFF, 0, visitor));
+        REQUIRE_FALSE(SparseMap::visit(0x0000u, 0, visitor));
+        REQUIRE_FALSE(SparseMap::visit(0x1001u, 0, visitor));
+        REQUIRE_FALSE(SparseMap::visit(0xFFFFFFFFu, 0, visitor));
+
+        REQUIRE(visitor.values.empty());
+    }
+
+    SECTION("Visitor can obtain the element of the map")
+    {
+        using Map = small_map<element<0x01, Reg8>, element<0x02, Reg8>>;
+        int visited_address{0};
+        unsigned value{0};
+
+        Map::visit(0x02, 0b01100, [&](auto element, auto r) {
+            visited_address = decltype(element)::address;
+            value = r.template get<reg::two>();
+        });
+
+        REQUIRE(visited_address == 0x02);
+        REQUIRE(value == 0b01100);
+    }
+}
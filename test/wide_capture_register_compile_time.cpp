@@ -0,0 +1,25 @@
+/**
+ * @file	wide_capture_register_compile_time.cpp
+ * @brief	Test for static assertion is triggered when a capture is decoded through a map with 64-bit registers.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/capture.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+void wide_capture_register_compile_time()
+{
+    using Reg1 = small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 6>>;
+    using Reg2 = small_register<uint64_t, bitfield<reg::three, 32>, bitfield<reg::four, 32>>;
+
+    using MemoryMap = small_map<element<0x01, Reg1>, element<0x02, Reg2>>;
+
+    capture_record record{};
+    columns<MemoryMap, 0x01>(&record, &record + 1);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file	wide_register.cpp
+ * @brief	Tests registers backed by arrays of words or bytes, with bitfields spanning the word boundaries.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+#include "small_register/wide_register.hpp"
+
+#include "helpers.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+using namespace jungles;
+
+TEST_CASE("Registers backed by arrays of 64-bit words", "[wide_register]")
+{
+    using Reg = wide_register<std::array<uint64_t, 2>,
+                              bitfield<reg::one, 4>,
+                              bitfield<reg::two, 64>,
+                              bitfield<reg::three, 60>>;
+
+    SECTION("64-bit bitfield spanning two words is read")
+    {
+        Reg r{{0x1234'5678'9ABC'DEF0, 0x1FED'CBA9'8765'4321}};
+        REQUIRE(r.get<reg::one>() == 0x1);
+        REQUIRE(r.get<reg::two>() == 0x2345'6789'ABCD'EF01);
+        REQUIRE(r.get<reg::three>() == 0xFED'CBA9'8765'4321);
+    }
+
+    SECTION("64-bit bitfield spanning two words is assigned")
+    {
+        Reg r{{0xFFFF'FFFF'FFFF'FFFF, 0xFFFF'FFFF'FFFF'FFFF}};
+        r.assign<reg::two>(0x0123'4567'89AB'CDEF);
+        REQUIRE(r()[0] == 0xF012'3456'789A'BCDE);
+        REQUIRE(r()[1] == 0xFFFF'FFFF'FFFF'FFFF);
+        REQUIRE(r.get<reg::one>() == 0xF);
+        REQUIRE(r.get<reg::two>() == 0x0123'4567'89AB'CDEF);
+        REQUIRE(r.get<reg::three>() == 0xFFF'FFFF'FFFF'FFFF);
+    }
+
+    SECTION("Bitfields are set and cleared")
+    {
+        Reg r;
+        r.set<reg::two>().clear<reg::two>(0xF000'0000'0000'000F).set<reg::one>(0x8);
+        REQUIRE(r()[0] == 0x80FF'FFFF'FFFF'FFFF);
+        REQUIRE(r()[1] == 0x0000'0000'0000'0000);
+        REQUIRE(r.get<reg::two>() == 0x0FFF'FFFF'FFFF'FFF0);
+    }
+
+    SECTION("Value not fitting the bitfield throws")
+    {
+        Reg r;
+        REQUIRE_THROWS_AS(r.assign<reg::three>(0x1000'0000'0000'0000), Reg::overflow_error);
+        REQUIRE_THROWS_AS(r.clear<reg::one>(0x10), Reg::mask_not_matching_error);
+    }
+}
+
+TEST_CASE("Registers backed by arrays of 32-bit words", "[wide_register]")
+{
+    using Reg = wide_register<std::array<uint32_t, 3>,
+                              bitfield<reg::one, 24>,
+                              bitfield<reg::two, 48>,
+                              bitfield<reg::three, 24>>;
+
+    Reg r{{0x1122'3344, 0x5566'7788, 0x99AA'BBCC}};
+    REQUIRE(r.get<reg::one>() == 0x11'2233);
+    REQUIRE(r.get<reg::two>() == 0x4455'6677'8899);
+    REQUIRE(r.get<reg::three>() == 0xAA'BBCC);
+
+    r.assign<reg::two>(0xA0B0'C0D0'E0F0);
+    REQUIRE(r() == std::array<uint32_t, 3>{0x1122'33A0, 0xB0C0'D0E0, 0xF0AA'BBCC});
+}
+
+TEST_CASE("Registers backed by byte arrays", "[wide_register]")
+{
+    SECTION("Frame shorter than 64 bits")
+    {
+        // Two 24-bit samples of an ADC, as received over SPI.
+        using Frame = wide_register<std::array<uint8_t, 6>,
+                                    bitfield<reg::one, 4>,
+                                    bitfield<reg::two, 20>,
+                                    bitfield<reg::three, 4>,
+                                    bitfield<reg::four, 20>>;
+
+        Frame f{{0xA1, 0x23, 0x45, 0xB6, 0x78, 0x9A}};
+        REQUIRE(f.get<reg::one>() == 0xA);
+        REQUIRE(f.get<reg::two>() == 0x1'2345);
+        REQUIRE(f.get<reg::three>() == 0xB);
+        REQUIRE(f.get<reg::four>() == 0x6'789A);
+
+        f.assign<reg::two>(0xF'EDCB).clear<reg::three>();
+        REQUIRE(f() == std::array<uint8_t, 6>{0xAF, 0xED, 0xCB, 0x06, 0x78, 0x9A});
+    }
+
+    SECTION("Bitfields at odd offsets of a 16-byte header")
+    {
+        using Header = wide_register<std::array<std::byte, 16>,
+                                     bitfield<reg::one, 3>,
+                                     bitfield<reg::two, 64>,
+                                     bitfield<reg::three, 57>,
+                                     bitfield<reg::four, 4>>;
+
+        Header h;
+        h.assign<reg::two>(0xFEDC'BA98'7654'3210).assign<reg::three>(0x1'0000'0000'0001).set<reg::four>(0x5);
+        h.set<reg::one>();
+        REQUIRE(h.get<reg::one>() == 0x7);
+        REQUIRE(h.get<reg::two>() == 0xFEDC'BA98'7654'3210);
+        REQUIRE(h.get<reg::three>() == 0x1'0000'0000'0001);
+        REQUIRE(h.get<reg::four>() == 0x5);
+        REQUIRE(h()[0] == std::byte{0xFF});
+        REQUIRE(h()[8] == std::byte{0x00});
+        REQUIRE(h()[15] == std::byte{0x15});
+    }
+}
+
+TEST_CASE("Wide registers follow the overflow policies", "[wide_register]")
+{
+    using Storage = std::array<uint32_t, 2>;
+    using Reg = basic_wide_register<overflow::return_error, Storage, bitfield<reg::one, 20>, bitfield<reg::two, 44>>;
+
+    Reg r;
+    REQUIRE(r.assign<reg::two>(0x1000'0000'0000) == std::errc::value_too_large);
+    REQUIRE(r.assign<reg::two>(0xFFF'FFFF'FFFF) == std::errc{});
+    REQUIRE(r() == Storage{0x0000'0FFF, 0xFFFF'FFFF});
+
+    auto truncated{Reg::with_policy<overflow::truncate>{}.assign<reg::one>(0x12'3456)};
+    REQUIRE(truncated() == Storage{0x2345'6000, 0x0000'0000});
+}
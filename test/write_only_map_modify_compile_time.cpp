@@ -0,0 +1,25 @@
+/**
+ * @file	write_only_map_modify_compile_time.cpp
+ * @brief	Test for static assertion is triggered when a register with write-only and read-write bitfields is modified
+ *          over the bus without the values of the write-only bitfields.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/memory_transport.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+void write_only_map_modify_compile_time()
+{
+    using Reg = small_register<uint8_t, write_only<bitfield<reg::one, 1>>, bitfield<reg::two, 7>>;
+
+    using MemoryMap = small_map<element<0x01, Reg>>;
+
+    memory_transport<4> transport;
+    MemoryMap::modify<0x01>(transport, [](auto& reg) { reg.template set<reg::two>(0x01); });
+}
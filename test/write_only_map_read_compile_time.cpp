@@ -0,0 +1,25 @@
+/**
+ * @file	write_only_map_read_compile_time.cpp
+ * @brief	Test for static assertion is triggered when a register with only write-only bitfields is read over the bus.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/memory_transport.hpp"
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+void write_only_map_read_compile_time()
+{
+    using Reg1 = small_register<uint8_t, bitfield<reg::one, 2>, bitfield<reg::two, 6>>;
+    using Reg2 = small_register<uint8_t, write_only<bitfield<reg::three, 4>>, write_only<bitfield<reg::four, 4>>>;
+
+    using MemoryMap = small_map<element<0x01, Reg1>, element<0x02, Reg2>>;
+
+    memory_transport<4> transport;
+    MemoryMap::read<0x01, 0x02>(transport);
+}
@@ -0,0 +1,21 @@
+/**
+ * @file	write_only_mmio_get_compile_time.cpp
+ * @brief	Test for static assertion is triggered when a write-only bitfield of a memory-mapped register is read.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/mmio_register.hpp"
+#include "small_register/small_register.hpp"
+
+#include "helpers.hpp"
+
+#include <cstdint>
+
+using namespace jungles;
+
+void write_only_mmio_get_compile_time()
+{
+    using Reg = small_register<uint8_t, bitfield<reg::one, 7>, write_only<bitfield<reg::two, 1>>>;
+
+    volatile uint8_t memory{0};
+    mmio_register<Reg>{&memory}.get<reg::two>();
+}
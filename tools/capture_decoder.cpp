@@ -0,0 +1,238 @@
+/**
+ * @file	capture_decoder.cpp
+ * @brief	Command-line decoder of the captures of register traffic, for the registers of capture_map.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "small_register/capture.hpp"
+#include "small_register/format.hpp"
+
+#include SMALL_REGISTERS_CAPTURE_MAP
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <tuple>
+
+using namespace jungles;
+
+namespace
+{
+
+constexpr char usage[]{
+    "Usage:\n"
+    "  capture_decoder generate <capture> <records> [seed]\n"
+    "      Writes a synthetic capture of the registers of the map.\n"
+    "  capture_decoder columns <capture> <address> <prefix> [threads]\n"
+    "      Writes the timestamps to <prefix>.timestamp and each bitfield of the register under the address to\n"
+    "      <prefix>.<bitfield>, as arrays of the underlying type of the register.\n"
+    "  capture_decoder filter <capture> <address> <bitfield> <value> [threads]\n"
+    "      Prints the registers under the address, whose bitfield equals the value, as CSV.\n"};
+
+int print_usage()
+{
+    std::fputs(usage, stderr);
+    return EXIT_FAILURE;
+}
+
+std::optional<unsigned long long> parse_number(const char* text)
+{
+    char* end{nullptr};
+    errno = 0;
+    auto value{std::strtoull(text, &end, 0)};
+    if (errno != 0 || end == text || *end != '\0')
+        return std::nullopt;
+    return value;
+}
+
+template<typename Bitfield>
+std::string name_of()
+{
+    if constexpr (Bitfield::name != nullptr)
+        return Bitfield::name;
+    else
+        return std::to_string(static_cast<long long>(Bitfield::id));
+}
+
+//! Position of the bitfield with the name, in the order of declaration.
+template<typename... Bitfields>
+std::optional<std::size_t> find_bitfield(const std::string& name, std::tuple<Bitfields...>*)
+{
+    std::optional<std::size_t> result;
+    std::size_t position{0};
+    ((name_of<Bitfields>() == name ? void(result = position) : void(), ++position), ...);
+    return result;
+}
+
+//! Calls the function with the jungles::element under the address known at runtime.
+template<typename Function, typename... Elements>
+bool with_element(std::uint32_t address, Function function, std::tuple<Elements...>*)
+{
+    return ((address == static_cast<std::uint32_t>(Elements::address) && (function(Elements{}), true)) || ...);
+}
+
+void write_file(const std::string& path, const void* data, std::size_t size)
+{
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{std::fopen(path.c_str(), "wb"), &std::fclose};
+    if (!file || std::fwrite(data, 1, size, file.get()) != size || std::fclose(file.release()) != 0)
+        throw std::system_error{errno, std::generic_category(), path};
+}
+
+template<typename Column>
+void write_column(const std::string& path, const Column& column)
+{
+    write_file(path, column.data(), column.size() * sizeof(typename Column::value_type));
+}
+
+template<typename... Bitfields, typename Columns>
+void write_columns(const std::string& prefix, const Columns& result, std::tuple<Bitfields...>*)
+{
+    write_column(prefix + ".timestamp", result.timestamps);
+    std::size_t position{0};
+    (write_column(prefix + "." + name_of<Bitfields>(), result.fields[position++]), ...);
+}
+
+class stopwatch
+{
+  public:
+    //! Reports the throughput of the decoding to stderr.
+    void report(std::size_t records) const
+    {
+        std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+        std::fprintf(stderr,
+                     "Decoded %zu records in %.3f s (%.1f M records/s)\n",
+                     records,
+                     elapsed.count(),
+                     static_cast<double>(records) / elapsed.count() / 1e6);
+    }
+
+  private:
+    std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+};
+
+int generate(int argc, char* argv[])
+{
+    auto records{parse_number(argv[3])};
+    auto seed{argc > 4 ? parse_number(argv[4]) : std::optional<unsigned long long>{0}};
+    if (!records || !seed)
+        return print_usage();
+
+    capture_generator<capture_map>{*seed}.generate(argv[2], *records);
+    return EXIT_SUCCESS;
+}
+
+int extract_columns(int argc, char* argv[])
+{
+    auto address{parse_number(argv[3])};
+    auto threads{argc > 5 ? parse_number(argv[5]) : std::optional<unsigned long long>{0}};
+    if (!address || !threads)
+        return print_usage();
+
+    mapped_capture capture{argv[2]};
+    stopwatch watch;
+    auto is_found{with_element(
+        static_cast<std::uint32_t>(*address),
+        [&](auto element) {
+            using Element = decltype(element);
+            using Bitfields = typename Element::Register::bitfields;
+            auto result{columns<capture_map, Element::address>(
+                capture.begin(), capture.end(), static_cast<unsigned>(*threads))};
+            watch.report(capture.size());
+            write_columns(argv[4], result, static_cast<Bitfields*>(nullptr));
+        },
+        static_cast<capture_map::elements*>(nullptr))};
+
+    if (!is_found)
+        std::fprintf(stderr, "No register under the address %s\n", argv[3]);
+    return is_found ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int filter_records(int argc, char* argv[])
+{
+    auto address{parse_number(argv[3])};
+    auto value{parse_number(argv[5])};
+    auto threads{argc > 6 ? parse_number(argv[6]) : std::optional<unsigned long long>{0}};
+    if (!address || !value || !threads)
+        return print_usage();
+    auto expected{*value};
+
+    mapped_capture capture{argv[2]};
+    auto result{EXIT_FAILURE};
+    auto is_found{with_element(
+        static_cast<std::uint32_t>(*address),
+        [&](auto element) {
+            using Element = decltype(element);
+            using Register = typename Element::Register;
+            using Bitfields = typename Register::bitfields;
+
+            auto position{find_bitfield(argv[4], static_cast<Bitfields*>(nullptr))};
+            if (!position)
+            {
+                std::fprintf(stderr, "No bitfield %s in the register under the address %s\n", argv[4], argv[3]);
+                return;
+            }
+
+            stopwatch watch;
+            auto id{Register::fields[*position].id};
+            auto matches{filter<capture_map>(
+                capture.begin(),
+                capture.end(),
+                [id, expected](std::uint64_t, auto e, auto reg) {
+                    if constexpr (decltype(e)::address == Element::address)
+                        return reg.get(id) == expected;
+                    else
+                        return false;
+                },
+                static_cast<unsigned>(*threads))};
+            watch.report(capture.size());
+
+            char line[512];
+            auto header{format_header<Register>(std::begin(line), std::end(line))};
+            std::printf("timestamp,%.*s\n", static_cast<int>(header.ptr - line), line);
+            for (const auto& record : matches)
+            {
+                auto end{format<format_style::csv>(
+                    std::begin(line),
+                    std::end(line),
+                    Register{static_cast<typename Register::underlying_type>(record.value)})};
+                std::printf("%llu,%.*s\n",
+                            static_cast<unsigned long long>(record.timestamp),
+                            static_cast<int>(end.ptr - line),
+                            line);
+            }
+            result = EXIT_SUCCESS;
+        },
+        static_cast<capture_map::elements*>(nullptr))};
+
+    if (!is_found)
+        std::fprintf(stderr, "No register under the address %s\n", argv[3]);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (argc >= 4 && std::strcmp(argv[1], "generate") == 0)
+            return generate(argc, argv);
+        if (argc >= 5 && std::strcmp(argv[1], "columns") == 0)
+            return extract_columns(argc, argv);
+        if (argc >= 6 && std::strcmp(argv[1], "filter") == 0)
+            return filter_records(argc, argv);
+        return print_usage();
+    } catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
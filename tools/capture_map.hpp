@@ -0,0 +1,81 @@
+/**
+ * @file	capture_map.hpp
+ * @brief	Registers of the MP2695 charger, decoded by the capture decoder unless SMALL_REGISTERS_CAPTURE_MAP names
+ *          another header which defines capture_map.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef CAPTURE_MAP_HPP
+#define CAPTURE_MAP_HPP
+
+#include "small_register/small_map.hpp"
+#include "small_register/small_register.hpp"
+
+#include <cstdint>
+
+namespace mp2695
+{
+
+enum class charge_control1
+{
+    icc,
+    en_ntc,
+    ipre
+};
+
+enum class status
+{
+    reserved1,
+    chg_stat,
+    vppm_stat,
+    ippm_stat,
+    usb1_plug_in,
+    reserved2
+};
+
+enum class fault
+{
+    batt_uvlo,
+    reserved1,
+    chg_fault,
+    ntc_fault
+};
+
+inline constexpr char icc[]{"icc"};
+inline constexpr char en_ntc[]{"en_ntc"};
+inline constexpr char ipre[]{"ipre"};
+inline constexpr char reserved1[]{"reserved1"};
+inline constexpr char chg_stat[]{"chg_stat"};
+inline constexpr char vppm_stat[]{"vppm_stat"};
+inline constexpr char ippm_stat[]{"ippm_stat"};
+inline constexpr char usb1_plug_in[]{"usb1_plug_in"};
+inline constexpr char reserved2[]{"reserved2"};
+inline constexpr char batt_uvlo[]{"batt_uvlo"};
+inline constexpr char chg_fault[]{"chg_fault"};
+inline constexpr char ntc_fault[]{"ntc_fault"};
+
+using ChargeControl1 = jungles::small_register<uint8_t,
+                                               jungles::bitfield<charge_control1::icc, 5, icc>,
+                                               jungles::bitfield<charge_control1::en_ntc, 1, en_ntc>,
+                                               jungles::bitfield<charge_control1::ipre, 2, ipre>>;
+
+using Status = jungles::small_register<uint8_t,
+                                       jungles::bitfield<status::reserved1, 2, reserved1>,
+                                       jungles::bitfield<status::chg_stat, 2, chg_stat>,
+                                       jungles::bitfield<status::vppm_stat, 1, vppm_stat>,
+                                       jungles::bitfield<status::ippm_stat, 1, ippm_stat>,
+                                       jungles::bitfield<status::usb1_plug_in, 1, usb1_plug_in>,
+                                       jungles::bitfield<status::reserved2, 1, reserved2>>;
+
+using Fault = jungles::small_register<uint8_t,
+                                      jungles::bitfield<fault::batt_uvlo, 1, batt_uvlo>,
+                                      jungles::bitfield<fault::reserved1, 3, reserved1>,
+                                      jungles::bitfield<fault::chg_fault, 2, chg_fault>,
+                                      jungles::bitfield<fault::ntc_fault, 2, ntc_fault>>;
+
+} // namespace mp2695
+
+using capture_map = jungles::small_map<jungles::element<0x01, mp2695::ChargeControl1>,
+                                       jungles::element<0x05, mp2695::Status>,
+                                       jungles::element<0x06, mp2695::Fault>>;
+
+#endif /* CAPTURE_MAP_HPP */